@@ -0,0 +1,509 @@
+#include "EffectHotReloader.h"
+
+#include <cwchar>
+#include <fstream>
+
+#include "../../vendor/effekseer/src/Effekseer/Effekseer/Effekseer.Curve.h"
+#include "../../vendor/effekseer/src/Effekseer/Effekseer/Effekseer.ResourceManager.h"
+#include "../../vendor/effekseer/src/Effekseer/Effekseer/Effekseer.SoundLoader.h"
+#include "../../vendor/effekseer/src/Effekseer/Effekseer/Model/Model.h"
+
+namespace
+{
+    constexpr size_t MaxRecordCount = 32;
+
+    bool ReadFile(const std::wstring& path, std::vector<uint8_t>& data)
+    {
+        std::ifstream stream(std::filesystem::path(path), std::ios::binary | std::ios::ate);
+        if (!stream) return false;
+
+        auto size = static_cast<size_t>(stream.tellg());
+        data.resize(size);
+        stream.seekg(0);
+        return size == 0 || stream.read(reinterpret_cast<char*>(data.data()), size).good();
+    }
+
+    constexpr uint64_t HashSeed = 14695981039346656037ull;
+
+    uint64_t HashBytes(uint64_t hash, const uint8_t* data, size_t size)
+    {
+        for (size_t i = 0; i < size; i++)
+        {
+            hash = (hash ^ data[i]) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    uint64_t HashData(const std::vector<uint8_t>& data)
+    {
+        auto hash = HashBytes(HashSeed, data.data(), data.size());
+        return hash != 0 ? hash : 1;
+    }
+
+    // FNV-1a over the file read in chunks, so large textures and models are never held in memory. 0 stands for a missing file.
+    uint64_t HashFile(const std::wstring& path)
+    {
+        std::ifstream stream(std::filesystem::path(path), std::ios::binary);
+        if (!stream) return 0;
+
+        uint64_t hash = HashSeed;
+        std::vector<char> buffer(64 * 1024);
+        while (stream)
+        {
+            stream.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            hash = HashBytes(hash, reinterpret_cast<const uint8_t*>(buffer.data()), static_cast<size_t>(stream.gcount()));
+        }
+        if (!stream.eof()) return 0;
+        return hash != 0 ? hash : 1;
+    }
+
+    // Same result as the PathCombine Effekseer uses to load resources, normalized for comparison.
+    std::wstring ResolvePath(const std::filesystem::path& directory, const char16_t* relativePath)
+    {
+        std::u16string relative = relativePath != nullptr ? relativePath : u"";
+        for (auto& c : relative)
+        {
+            if (c == u'\\') c = u'/';
+        }
+        return (directory / std::filesystem::path(relative)).lexically_normal().wstring();
+    }
+
+    double ToMilliseconds(std::chrono::steady_clock::duration duration)
+    {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+}
+
+namespace EffekseerForNative
+{
+    EffectHotReloader::EffectHotReloader(const ::Effekseer::ManagerRef& manager, int32_t debounceMilliseconds)
+        : manager_(manager)
+        , validationSetting_(::Effekseer::Setting::Create())
+        , debounce_(std::chrono::milliseconds(debounceMilliseconds > 0 ? debounceMilliseconds : 0))
+        , pollInterval_(std::chrono::milliseconds(debounceMilliseconds > 200 ? 100 : (debounceMilliseconds > 0 ? debounceMilliseconds / 2 : 0)))
+    {
+    }
+
+    void EffectHotReloader::Track(const std::wstring& key, const ::Effekseer::EffectRef& effect, const std::filesystem::path& path)
+    {
+        if (effect == nullptr)
+        {
+            Untrack(key);
+            return;
+        }
+
+        TrackedEffect tracked;
+        tracked.Effect = effect;
+        tracked.Path = path.lexically_normal().wstring();
+        CollectResources(tracked);
+
+        // Watch the new file set before dropping the old one, so files that stay keep their state and are not hashed again.
+        Watch(tracked.Path, key);
+        for (const auto& resource : tracked.Resources)
+        {
+            Watch(resource.Path, key);
+        }
+
+        auto it = effects_.find(key);
+        if (it != effects_.end())
+        {
+            std::unordered_set<std::wstring> paths;
+            paths.insert(tracked.Path);
+            for (const auto& resource : tracked.Resources)
+            {
+                paths.insert(resource.Path);
+            }
+
+            if (paths.count(it->second.Path) == 0) Unwatch(it->second.Path, key);
+            for (const auto& resource : it->second.Resources)
+            {
+                if (paths.count(resource.Path) == 0) Unwatch(resource.Path, key);
+            }
+        }
+
+        effects_[key] = std::move(tracked);
+    }
+
+    void EffectHotReloader::Untrack(const std::wstring& key)
+    {
+        auto it = effects_.find(key);
+        if (it == effects_.end()) return;
+
+        Unwatch(it->second.Path, key);
+        for (const auto& resource : it->second.Resources)
+        {
+            Unwatch(resource.Path, key);
+        }
+        effects_.erase(it);
+    }
+
+    void EffectHotReloader::Clear()
+    {
+        effects_.clear();
+        files_.clear();
+    }
+
+    std::vector<std::wstring> EffectHotReloader::Poll(Clock::time_point now)
+    {
+        if (now - lastPoll_ < pollInterval_) return {};
+        lastPoll_ = now;
+
+        std::unordered_set<std::wstring> changedPaths;
+        auto changedAt = now;
+
+        for (auto& [path, file] : files_)
+        {
+            std::error_code error;
+            auto exists = std::filesystem::is_regular_file(path, error);
+            auto writeTime = exists ? std::filesystem::last_write_time(path, error) : std::filesystem::file_time_type();
+            auto size = exists ? std::filesystem::file_size(path, error) : 0;
+            if (error) exists = false;
+
+            if (exists != file.Exists || writeTime != file.WriteTime || size != file.Size)
+            {
+                file.Exists = exists;
+                file.WriteTime = writeTime;
+                file.Size = size;
+                file.LastChangedAt = now;
+                if (!file.Pending)
+                {
+                    file.Pending = true;
+                    file.FirstChangedAt = now;
+                }
+                continue;
+            }
+
+            if (!file.Pending || now - file.LastChangedAt < debounce_) continue;
+            file.Pending = false;
+
+            // A file that disappeared is left alone until it comes back.
+            if (!file.Exists) continue;
+
+            // Touching a file or re-exporting identical bytes is not a change. Only a file of the size
+            // loaded last can be identical, so other sizes are taken as changed without reading them.
+            // LoadedSize and LoadedHash move on only once a reload has taken the new bytes.
+            if (file.Size == file.LoadedSize)
+            {
+                auto hash = HashFile(path);
+                if (hash == 0) continue;
+
+                // Without the hash of the loaded bytes the file can not be proven identical.
+                if (file.LoadedHash != 0 && hash == file.LoadedHash) continue;
+            }
+
+            changedPaths.insert(path);
+            if (file.FirstChangedAt < changedAt) changedAt = file.FirstChangedAt;
+        }
+
+        if (changedPaths.empty()) return {};
+
+        std::vector<std::wstring> keys;
+        for (const auto& [key, tracked] : effects_)
+        {
+            bool changed = changedPaths.count(tracked.Path) > 0;
+            for (size_t i = 0; !changed && i < tracked.Resources.size(); i++)
+            {
+                changed = changedPaths.count(tracked.Resources[i].Path) > 0;
+            }
+            if (changed) keys.push_back(key);
+        }
+
+        return Reload(keys, changedPaths, changedAt);
+    }
+
+    std::wstring EffectHotReloader::FormatReport() const
+    {
+        std::wstring report;
+        wchar_t line[512];
+        for (const auto& record : records_)
+        {
+            auto name = std::filesystem::path(record.Key).filename().wstring();
+            if (record.Succeeded)
+            {
+                swprintf(line, sizeof(line) / sizeof(line[0]), L"%ls: %ls%d changed resources reloaded, %d kept resident, %.1f ms from change to swap (reload %.1f ms)\n",
+                    name.c_str(),
+                    record.BodyReloaded ? L"effect and " : L"",
+                    record.ReloadedResources,
+                    record.KeptResources,
+                    record.LatencyMilliseconds,
+                    record.ReloadMilliseconds);
+            }
+            else
+            {
+                swprintf(line, sizeof(line) / sizeof(line[0]), L"%ls: the changed effect could not be loaded, the previous version is kept\n", name.c_str());
+            }
+            report += line;
+        }
+        return report;
+    }
+
+    void EffectHotReloader::Watch(const std::wstring& path, const std::wstring& key)
+    {
+        auto it = files_.find(path);
+        if (it == files_.end())
+        {
+            WatchedFile file;
+            std::error_code error;
+            file.Exists = std::filesystem::is_regular_file(path, error);
+            if (file.Exists)
+            {
+                file.WriteTime = std::filesystem::last_write_time(path, error);
+                file.Size = std::filesystem::file_size(path, error);
+                file.LoadedSize = file.Size;
+                file.LoadedHash = HashFile(path);
+            }
+            it = files_.emplace(path, std::move(file)).first;
+        }
+        it->second.Keys.insert(key);
+    }
+
+    void EffectHotReloader::Unwatch(const std::wstring& path, const std::wstring& key)
+    {
+        auto it = files_.find(path);
+        if (it == files_.end()) return;
+
+        it->second.Keys.erase(key);
+        if (it->second.Keys.empty())
+        {
+            files_.erase(it);
+        }
+    }
+
+    void EffectHotReloader::CollectResources(TrackedEffect& tracked) const
+    {
+        const auto& effect = tracked.Effect;
+        auto directory = std::filesystem::path(tracked.Path).parent_path();
+
+        tracked.Resources.clear();
+        auto add = [&](ResourceType type, int32_t count, auto getPath)
+        {
+            for (int32_t i = 0; i < count; i++)
+            {
+                tracked.Resources.push_back({type, i, ResolvePath(directory, getPath(i))});
+            }
+        };
+
+        add(ResourceType::ColorImage, effect->GetColorImageCount(), [&](int32_t i) { return effect->GetColorImagePath(i); });
+        add(ResourceType::NormalImage, effect->GetNormalImageCount(), [&](int32_t i) { return effect->GetNormalImagePath(i); });
+        add(ResourceType::DistortionImage, effect->GetDistortionImageCount(), [&](int32_t i) { return effect->GetDistortionImagePath(i); });
+        add(ResourceType::Wave, effect->GetWaveCount(), [&](int32_t i) { return effect->GetWavePath(i); });
+        add(ResourceType::Model, effect->GetModelCount(), [&](int32_t i) { return effect->GetModelPath(i); });
+        add(ResourceType::Material, effect->GetMaterialCount(), [&](int32_t i) { return effect->GetMaterialPath(i); });
+        add(ResourceType::Curve, effect->GetCurveCount(), [&](int32_t i) { return effect->GetCurvePath(i); });
+    }
+
+    std::vector<std::wstring> EffectHotReloader::Reload(const std::vector<std::wstring>& keys, const std::unordered_set<std::wstring>& changedPaths, Clock::time_point changedAt)
+    {
+        auto resourceManager = manager_->GetSetting()->GetResourceManager();
+
+        struct PendingReload
+        {
+            std::wstring Key;
+            TrackedEffect* Tracked;
+            bool BodyChanged;
+            std::vector<uint8_t> Body;
+            HotReloadRecord Record;
+        };
+
+        // Pinned resources hold an extra reference in the ResourceManager cache, so unloading the
+        // effect does not release them and the reload gets the resident copy back.
+        struct PinnedResource
+        {
+            ::Effekseer::TextureRef Texture;
+            ::Effekseer::TextureType TextureType = ::Effekseer::TextureType::Color;
+            ::Effekseer::SoundDataRef Wave;
+            ::Effekseer::ModelRef Model;
+            ::Effekseer::MaterialRef Material;
+            ::Effekseer::CurveRef Curve;
+        };
+
+        std::vector<PendingReload> reloads;
+        std::vector<PinnedResource> pinned;
+
+        for (const auto& key : keys)
+        {
+            auto start = Clock::now();
+
+            PendingReload reload;
+            reload.Key = key;
+            reload.Tracked = &effects_[key];
+            reload.BodyChanged = changedPaths.count(reload.Tracked->Path) > 0;
+            reload.Record.Key = key;
+            reload.Record.BodyReloaded = reload.BodyChanged;
+
+            if (reload.BodyChanged)
+            {
+                auto directory = std::filesystem::path(reload.Tracked->Path).parent_path().u16string() + u"/";
+                if (!ReadFile(reload.Tracked->Path, reload.Body) ||
+                    ::Effekseer::Effect::Create(validationSetting_, reload.Body.data(), static_cast<int32_t>(reload.Body.size()), 1.0f, directory.c_str()) == nullptr)
+                {
+                    AddRecord(reload.Record);
+
+                    // The previous body stays, but resources that changed in the same poll are still reloaded into it.
+                    bool resourceChanged = false;
+                    for (const auto& resource : reload.Tracked->Resources)
+                    {
+                        resourceChanged = resourceChanged || changedPaths.count(resource.Path) > 0;
+                    }
+                    if (!resourceChanged) continue;
+
+                    reload.BodyChanged = false;
+                    reload.Body.clear();
+                    reload.Record.BodyReloaded = false;
+                }
+            }
+
+            const auto& effect = reload.Tracked->Effect;
+            for (const auto& resource : reload.Tracked->Resources)
+            {
+                if (changedPaths.count(resource.Path) > 0)
+                {
+                    reload.Record.ReloadedResources++;
+                    continue;
+                }
+
+                PinnedResource pin;
+                switch (resource.Type)
+                {
+                case ResourceType::ColorImage:
+                case ResourceType::NormalImage:
+                case ResourceType::DistortionImage:
+                {
+                    auto texture = resource.Type == ResourceType::ColorImage    ? effect->GetColorImage(resource.Index)
+                                   : resource.Type == ResourceType::NormalImage ? effect->GetNormalImage(resource.Index)
+                                                                                : effect->GetDistortionImage(resource.Index);
+                    pin.TextureType = resource.Type == ResourceType::ColorImage    ? ::Effekseer::TextureType::Color
+                                      : resource.Type == ResourceType::NormalImage ? ::Effekseer::TextureType::Normal
+                                                                                   : ::Effekseer::TextureType::Distortion;
+                    if (texture != nullptr && !texture->GetPath().empty())
+                        pin.Texture = resourceManager->LoadTexture(texture->GetPath().c_str(), pin.TextureType);
+                    break;
+                }
+                case ResourceType::Wave:
+                {
+                    auto wave = effect->GetWave(resource.Index);
+                    if (wave != nullptr && !wave->GetPath().empty())
+                        pin.Wave = resourceManager->LoadSoundData(wave->GetPath().c_str());
+                    break;
+                }
+                case ResourceType::Model:
+                {
+                    auto model = effect->GetModel(resource.Index);
+                    if (model != nullptr && !model->GetPath().empty())
+                        pin.Model = resourceManager->LoadModel(model->GetPath().c_str());
+                    break;
+                }
+                case ResourceType::Material:
+                {
+                    auto material = effect->GetMaterial(resource.Index);
+                    if (material != nullptr && !material->GetPath().empty())
+                        pin.Material = resourceManager->LoadMaterial(material->GetPath().c_str());
+                    break;
+                }
+                case ResourceType::Curve:
+                {
+                    auto curve = effect->GetCurve(resource.Index);
+                    if (curve != nullptr && !curve->GetPath().empty())
+                        pin.Curve = resourceManager->LoadCurve(curve->GetPath().c_str());
+                    break;
+                }
+                }
+
+                reload.Record.KeptResources++;
+                pinned.push_back(pin);
+            }
+
+            reload.Record.ReloadMilliseconds = ToMilliseconds(Clock::now() - start);
+            reloads.push_back(std::move(reload));
+        }
+
+        // Release every affected effect first so a changed resource shared between them drops out of the cache.
+        for (auto& reload : reloads)
+        {
+            reload.Tracked->Effect->UnloadResources();
+        }
+
+        for (auto& reload : reloads)
+        {
+            auto start = Clock::now();
+            auto& effect = reload.Tracked->Effect;
+
+            if (reload.BodyChanged)
+            {
+                // Stops the instances of this effect and replays them to their current frame on the new data,
+                // so handles and the timeline survive the swap.
+                effect->Reload(&manager_, 1, reload.Body.data(), static_cast<int32_t>(reload.Body.size()));
+            }
+            else
+            {
+                effect->ReloadResources();
+            }
+
+            reload.Record.ReloadMilliseconds += ToMilliseconds(Clock::now() - start);
+        }
+
+        for (const auto& pin : pinned)
+        {
+            if (pin.Texture != nullptr) resourceManager->UnloadTexture(pin.Texture);
+            if (pin.Wave != nullptr) resourceManager->UnloadSoundData(pin.Wave);
+            if (pin.Model != nullptr) resourceManager->UnloadModel(pin.Model);
+            if (pin.Material != nullptr) resourceManager->UnloadMaterial(pin.Material);
+            if (pin.Curve != nullptr) resourceManager->UnloadCurve(pin.Curve);
+        }
+
+        // Only the files a reload took count as loaded, so a broken body is retried on its next change
+        // and touching a reloaded file again is recognized as identical.
+        std::unordered_set<std::wstring> loadedResources;
+        for (const auto& reload : reloads)
+        {
+            if (reload.BodyChanged)
+            {
+                MarkLoaded(reload.Tracked->Path, reload.Body.size(), HashData(reload.Body));
+            }
+            for (const auto& resource : reload.Tracked->Resources)
+            {
+                if (changedPaths.count(resource.Path) > 0 && loadedResources.insert(resource.Path).second)
+                {
+                    std::error_code error;
+                    auto size = std::filesystem::file_size(resource.Path, error);
+                    if (!error) MarkLoaded(resource.Path, size, HashFile(resource.Path));
+                }
+            }
+        }
+
+        std::vector<std::wstring> reloadedKeys;
+        auto swappedAt = Clock::now();
+        for (auto& reload : reloads)
+        {
+            // The new body may reference different files.
+            auto key = reload.Key;
+            auto effect = reload.Tracked->Effect;
+            auto path = reload.Tracked->Path;
+            Track(key, effect, path);
+
+            reload.Record.Succeeded = true;
+            reload.Record.LatencyMilliseconds = ToMilliseconds(swappedAt - changedAt);
+            AddRecord(reload.Record);
+            reloadedKeys.push_back(reload.Key);
+        }
+        return reloadedKeys;
+    }
+
+    void EffectHotReloader::MarkLoaded(const std::wstring& path, uintmax_t size, uint64_t hash)
+    {
+        auto it = files_.find(path);
+        if (it == files_.end()) return;
+
+        it->second.LoadedSize = size;
+        it->second.LoadedHash = hash;
+    }
+
+    void EffectHotReloader::AddRecord(const HotReloadRecord& record)
+    {
+        if (records_.size() >= MaxRecordCount)
+        {
+            records_.erase(records_.begin());
+        }
+        records_.push_back(record);
+    }
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+// Watches loaded effects and the textures, models, sounds, materials and curves they reference,
+// and reloads them in place when their bytes change on disk. Files are polled from Update() so no
+// extra thread touches the manager; a change is applied once the file has stopped changing for the
+// debounce interval, which skips the partial writes an exporter produces while saving.
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <Effekseer.h>
+
+namespace EffekseerForNative
+{
+    struct HotReloadRecord
+    {
+        std::wstring Key;
+        bool Succeeded = false;
+        bool BodyReloaded = false;
+        int32_t ReloadedResources = 0;
+        int32_t KeptResources = 0;
+        // From the first change seen on disk to the swapped effect, including the debounce interval.
+        double LatencyMilliseconds = 0.0;
+        // Reading, validating and reloading only.
+        double ReloadMilliseconds = 0.0;
+    };
+
+    class EffectHotReloader
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        EffectHotReloader(const ::Effekseer::ManagerRef& manager, int32_t debounceMilliseconds);
+
+        // path is the effect file; resource paths are resolved against its directory like Effect::Create does.
+        void Track(const std::wstring& key, const ::Effekseer::EffectRef& effect, const std::filesystem::path& path);
+        void Untrack(const std::wstring& key);
+        void Clear();
+
+        // Reloads the tracked effects whose files changed and settled. Returns the keys that were swapped.
+        std::vector<std::wstring> Poll(Clock::time_point now);
+
+        const std::vector<HotReloadRecord>& GetRecords() const { return records_; }
+
+        // One line per reload, most recent last.
+        std::wstring FormatReport() const;
+
+    private:
+        enum class ResourceType
+        {
+            ColorImage,
+            NormalImage,
+            DistortionImage,
+            Wave,
+            Model,
+            Material,
+            Curve,
+        };
+
+        struct TrackedResource
+        {
+            ResourceType Type;
+            int32_t Index;
+            std::wstring Path;
+        };
+
+        struct TrackedEffect
+        {
+            ::Effekseer::EffectRef Effect;
+            std::wstring Path;
+            std::vector<TrackedResource> Resources;
+        };
+
+        struct WatchedFile
+        {
+            bool Exists = false;
+            std::filesystem::file_time_type WriteTime;
+            uintmax_t Size = 0;
+            // The bytes the tracked effects were loaded from. LoadedHash is 0 when those bytes were not hashed.
+            uintmax_t LoadedSize = 0;
+            uint64_t LoadedHash = 0;
+            bool Pending = false;
+            Clock::time_point FirstChangedAt;
+            Clock::time_point LastChangedAt;
+            std::unordered_set<std::wstring> Keys;
+        };
+
+        void Watch(const std::wstring& path, const std::wstring& key);
+        void Unwatch(const std::wstring& path, const std::wstring& key);
+        void CollectResources(TrackedEffect& tracked) const;
+        std::vector<std::wstring> Reload(const std::vector<std::wstring>& keys, const std::unordered_set<std::wstring>& changedPaths, Clock::time_point changedAt);
+        void MarkLoaded(const std::wstring& path, uintmax_t size, uint64_t hash);
+        void AddRecord(const HotReloadRecord& record);
+
+        ::Effekseer::ManagerRef manager_;
+        // Parses changed effect bodies without resource loaders, so a broken export never replaces a working effect.
+        ::Effekseer::SettingRef validationSetting_;
+        Clock::duration debounce_;
+        Clock::duration pollInterval_;
+        Clock::time_point lastPoll_;
+
+        std::unordered_map<std::wstring, TrackedEffect> effects_;
+        std::unordered_map<std::wstring, WatchedFile> files_;
+        std::vector<HotReloadRecord> records_;
+    };
+}
@@ -1,7 +1,13 @@
 #include "EffectsManager.h"
+#include "EffectHotReloader.h"
+#include "MappedFile.h"
+#include "NodeStatistics.h"
+#include "SoftwareRenderer.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <chrono>
+#include <cstring>
 #include <mutex>
 #include <Windows.h>
 
@@ -32,6 +38,20 @@ namespace
         return result;
     }
 
+    void InstallEffekseerLogger()
+    {
+        Effekseer::SetLogger([](Effekseer::LogType logType, const std::string& message)
+            {
+                if (logType != Effekseer::LogType::Error && logType != Effekseer::LogType::Warning)
+                {
+                    return;
+                }
+
+                std::lock_guard<std::mutex> lock(g_effekseerLogMutex);
+                g_lastEffekseerErrorUtf8 = message;
+            });
+    }
+
     void ClearLastEffekseerError()
     {
         std::lock_guard<std::mutex> lock(g_effekseerLogMutex);
@@ -47,18 +67,15 @@ namespace
     }
 }
 
+EffectsManager::~EffectsManager() = default;
+
 bool EffectsManager::Initialize(ID3D11Device* device, ID3D11DeviceContext* context)
 {
-    Effekseer::SetLogger([](Effekseer::LogType logType, const std::string& message)
-        {
-            if (logType != Effekseer::LogType::Error && logType != Effekseer::LogType::Warning)
-            {
-                return;
-            }
+    InstallEffekseerLogger();
 
-            std::lock_guard<std::mutex> lock(g_effekseerLogMutex);
-            g_lastEffekseerErrorUtf8 = message;
-        });
+    // A renderer from an earlier InitializeSoftware or InitializeCapture must not outlive this call.
+    softwareRenderer_ = nullptr;
+    renderer_.Reset();
 
     if (device != nullptr && context != nullptr)
     {
@@ -66,20 +83,64 @@ bool EffectsManager::Initialize(ID3D11Device* device, ID3D11DeviceContext* conte
         if (renderer_.Get() == nullptr) return false;
     }
 
-    manager_ = ::Effekseer::Manager::Create(2000);
+    return InitializeManager();
+}
+
+bool EffectsManager::InitializeSoftware(int width, int height, int threadCount)
+{
+    InstallEffekseerLogger();
+
+    auto renderer = EffekseerForNative::SoftwareRenderer::Create(width, height, 2000, threadCount);
+    if (renderer.Get() == nullptr) return false;
+
+    softwareRenderer_ = renderer.Get();
+    renderer_ = renderer;
+
+    return InitializeManager();
+}
+
+bool EffectsManager::InitializeCapture()
+{
+    InstallEffekseerLogger();
+
+    auto renderer = EffekseerForNative::SoftwareRenderer::Create(0, 0, 2000);
+    if (renderer.Get() == nullptr) return false;
+
+    renderer->EnableVertexCapture();
+    softwareRenderer_ = renderer.Get();
+    renderer_ = renderer;
+
+    return InitializeManager();
+}
+
+bool EffectsManager::InitializeManager()
+{
+    manager_ = ::Effekseer::Manager::Create(instanceLimit_);
     if (manager_.Get() == nullptr) return false;
 
+    // Effects and resources are parsed straight from mapped files instead of being copied into buffers.
+    auto fileInterface = ::Effekseer::MakeRefPtr<EffekseerForNative::MappedFileInterface>();
+    manager_->SetEffectLoader(::Effekseer::Effect::CreateEffectLoader(fileInterface));
+
     if (renderer_.Get() != nullptr)
     {
+        renderer_->SetDirectEmissionEnabled(directEmissionEnabled_);
+        if (minCachedSplineSegmentCount_ >= 0)
+        {
+            renderer_->SetMinCachedSplineSegmentCount(minCachedSplineSegmentCount_);
+        }
+        renderer_->ResetStandardRendererStatistics();
+        uploadFrames_ = 0;
+
         manager_->SetSpriteRenderer(renderer_->CreateSpriteRenderer());
         manager_->SetRibbonRenderer(renderer_->CreateRibbonRenderer());
         manager_->SetRingRenderer(renderer_->CreateRingRenderer());
         manager_->SetTrackRenderer(renderer_->CreateTrackRenderer());
         manager_->SetModelRenderer(renderer_->CreateModelRenderer());
 
-        manager_->SetTextureLoader(renderer_->CreateTextureLoader());
-        manager_->SetModelLoader(renderer_->CreateModelLoader());
-        manager_->SetMaterialLoader(renderer_->CreateMaterialLoader());
+        manager_->SetTextureLoader(renderer_->CreateTextureLoader(fileInterface));
+        manager_->SetModelLoader(renderer_->CreateModelLoader(fileInterface));
+        manager_->SetMaterialLoader(renderer_->CreateMaterialLoader(fileInterface));
     }
     else
     {
@@ -143,16 +204,44 @@ void EffectsManager::SetSoundCallback(EffekseerForNative::LoadSoundFunc loadSoun
 
 void EffectsManager::Shutdown()
 {
+    hotReloader_.reset();
     effects_.clear();
+    effectPaths_.clear();
+    nodeStatisticsFrames_ = 0;
     manager_.Reset();
+    softwareRenderer_ = nullptr;
     renderer_.Reset();
 }
 
 void EffectsManager::Update(float deltaSeconds)
 {
     if (manager_.Get() == nullptr) return;
+
+    if (hotReloader_ != nullptr)
+    {
+        const auto reloadedKeys = hotReloader_->Poll(std::chrono::steady_clock::now());
+        for (const auto& key : reloadedKeys)
+        {
+            auto term = effects_[key]->CalculateTerm();
+            for (auto& a : active_)
+            {
+                if (a.key == key) a.termMax = term.TermMax;
+            }
+        }
+
+        // Costs measured before the reload must not be averaged with the new data, and every effect shares one frame count.
+        if (!reloadedKeys.empty())
+        {
+            ResetNodeStatistics();
+        }
+    }
+
     float deltaFrames = deltaSeconds * 60.0f;
     manager_->Update(deltaFrames);
+    if (manager_->GetNodeStatisticsEnabled())
+    {
+        nodeStatisticsFrames_++;
+    }
     if (renderer_.Get() != nullptr)
     {
         renderer_->SetTime(renderer_->GetTime() + deltaSeconds);
@@ -202,6 +291,111 @@ void EffectsManager::Draw()
     renderer_->BeginRendering();
     manager_->Draw();
     renderer_->EndRendering();
+    uploadFrames_++;
+}
+
+bool EffectsManager::CopySoftwareFrame(uint8_t* destination, int destinationStride, int destinationHeight) const
+{
+    if (softwareRenderer_ == nullptr || destination == nullptr || destinationStride <= 0 || destinationHeight <= 0) return false;
+
+    auto source = softwareRenderer_->GetFrameBuffer();
+    auto sourceStride = softwareRenderer_->GetFrameStride();
+    auto rowSize = sourceStride < destinationStride ? sourceStride : destinationStride;
+    auto height = softwareRenderer_->GetFrameHeight() < destinationHeight ? softwareRenderer_->GetFrameHeight() : destinationHeight;
+    for (int y = 0; y < height; y++)
+    {
+        memcpy(destination + static_cast<size_t>(y) * destinationStride, source + static_cast<size_t>(y) * sourceStride, rowSize);
+    }
+    return true;
+}
+
+int EffectsManager::GetSoftwareFrameWidth() const
+{
+    return softwareRenderer_ != nullptr ? softwareRenderer_->GetFrameWidth() : 0;
+}
+
+int EffectsManager::GetSoftwareFrameHeight() const
+{
+    return softwareRenderer_ != nullptr ? softwareRenderer_->GetFrameHeight() : 0;
+}
+
+std::wstring EffectsManager::GetCaptureReport() const
+{
+    if (softwareRenderer_ == nullptr || softwareRenderer_->GetVertexCapture() == nullptr) return L"";
+
+    auto report = softwareRenderer_->GetVertexCapture()->FormatReport();
+    return std::wstring(report.begin(), report.end());
+}
+
+void EffectsManager::ResetCaptureStatistics()
+{
+    if (softwareRenderer_ == nullptr || softwareRenderer_->GetVertexCapture() == nullptr) return;
+
+    softwareRenderer_->GetVertexCapture()->ResetStatistics();
+}
+
+const std::vector<uint8_t>* EffectsManager::GetCapturedVertexStream() const
+{
+    if (softwareRenderer_ == nullptr || softwareRenderer_->GetVertexCapture() == nullptr) return nullptr;
+
+    return &softwareRenderer_->GetVertexCapture()->GetVertexStream();
+}
+
+void EffectsManager::SetDirectEmissionEnabled(bool enabled)
+{
+    directEmissionEnabled_ = enabled;
+    if (renderer_.Get() != nullptr)
+    {
+        renderer_->SetDirectEmissionEnabled(enabled);
+    }
+}
+
+bool EffectsManager::GetDirectEmissionEnabled() const
+{
+    return directEmissionEnabled_;
+}
+
+void EffectsManager::SetMinCachedSplineSegmentCount(int count)
+{
+    minCachedSplineSegmentCount_ = count;
+    if (renderer_.Get() != nullptr && count >= 0)
+    {
+        renderer_->SetMinCachedSplineSegmentCount(count);
+    }
+}
+
+int EffectsManager::GetMinCachedSplineSegmentCount() const
+{
+    if (renderer_.Get() != nullptr) return renderer_->GetMinCachedSplineSegmentCount();
+
+    return minCachedSplineSegmentCount_;
+}
+
+std::wstring EffectsManager::GetUploadReport() const
+{
+    if (renderer_.Get() == nullptr || uploadFrames_ <= 0) return L"";
+
+    const auto upload = renderer_->GetStandardRendererStatistics();
+    const auto batches = upload.DirectBatches + upload.StagedBatches;
+    wchar_t line[256];
+    swprintf(line, sizeof(line) / sizeof(line[0]), L"Upload: %lld bytes/frame (direct %lld, staged %lld, copied %lld), %.0f%% of %lld batches direct, over %lld frames\n",
+        static_cast<long long>((upload.DirectBytes + upload.StagedBytes + upload.CopiedBytes) / uploadFrames_),
+        static_cast<long long>(upload.DirectBytes / uploadFrames_),
+        static_cast<long long>(upload.StagedBytes / uploadFrames_),
+        static_cast<long long>(upload.CopiedBytes / uploadFrames_),
+        batches > 0 ? upload.DirectBatches * 100.0 / batches : 0.0,
+        static_cast<long long>(batches),
+        static_cast<long long>(uploadFrames_));
+    return line;
+}
+
+void EffectsManager::ResetUploadStatistics()
+{
+    if (renderer_.Get() != nullptr)
+    {
+        renderer_->ResetStandardRendererStatistics();
+    }
+    uploadFrames_ = 0;
 }
 
 bool EffectsManager::LoadEffect(const std::wstring& key, const std::wstring& path)
@@ -229,10 +423,67 @@ bool EffectsManager::LoadEffect(const std::wstring& key, const std::wstring& pat
         return false;
     }
     effects_[key] = effect;
+    effectPaths_[key] = path;
+    if (hotReloader_ != nullptr)
+    {
+        hotReloader_->Track(key, effect, p);
+    }
 
     return true;
 }
 
+void EffectsManager::EnableHotReload(bool enabled, int debounceMilliseconds)
+{
+    hotReloader_.reset();
+    if (!enabled || manager_.Get() == nullptr) return;
+
+    hotReloader_ = std::make_unique<EffekseerForNative::EffectHotReloader>(manager_, debounceMilliseconds);
+    for (const auto& [key, effect] : effects_)
+    {
+        hotReloader_->Track(key, effect, effectPaths_[key]);
+    }
+}
+
+std::wstring EffectsManager::GetHotReloadReport() const
+{
+    if (hotReloader_ == nullptr) return L"";
+
+    return hotReloader_->FormatReport();
+}
+
+void EffectsManager::EnableNodeStatistics(bool enabled)
+{
+    if (manager_.Get() == nullptr) return;
+
+    manager_->SetNodeStatisticsEnabled(enabled);
+}
+
+std::wstring EffectsManager::GetNodeStatisticsReport(int heaviestCount) const
+{
+    std::vector<std::wstring> keys;
+    for (const auto& [key, effect] : effects_)
+    {
+        keys.push_back(key);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<EffekseerForNative::NodeStatisticsEntry> entries;
+    for (const auto& key : keys)
+    {
+        EffekseerForNative::CollectNodeStatistics(key, effects_.at(key), entries);
+    }
+    return EffekseerForNative::FormatNodeStatisticsReport(entries, nodeStatisticsFrames_, heaviestCount);
+}
+
+void EffectsManager::ResetNodeStatistics()
+{
+    for (const auto& [key, effect] : effects_)
+    {
+        EffekseerForNative::ResetNodeStatistics(effect);
+    }
+    nodeStatisticsFrames_ = 0;
+}
+
 void EffectsManager::PlayEffect(const std::wstring& key, float x, float y, float z)
 {
     if (manager_.Get() == nullptr) return;
@@ -358,6 +609,23 @@ void EffectsManager::SetMaxDurationSeconds(int seconds)
     maxDurationSeconds_ = seconds;
 }
 
+void EffectsManager::SetInstanceLimit(int limit)
+{
+    instanceLimit_ = limit > 0 ? limit : 0;
+}
+
+int EffectsManager::GetInstanceLimit() const
+{
+    return instanceLimit_;
+}
+
+size_t EffectsManager::GetAllocatedInstanceBytes() const
+{
+    if (manager_.Get() == nullptr) return 0;
+
+    return manager_->GetAllocatedInstanceBytes();
+}
+
 const std::wstring& EffectsManager::GetLastPlayedKey() const
 {
     return lastPlayedKey_;
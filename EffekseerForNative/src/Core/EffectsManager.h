@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -9,11 +10,22 @@
 #include <EffekseerRendererDX11.h>
 #include "EffekseerSound.h"
 
+namespace EffekseerForNative
+{
+    class SoftwareRenderer;
+    class EffectHotReloader;
+}
 
 class EffectsManager
 {
 public:
+    ~EffectsManager();
+
     bool Initialize(ID3D11Device* device, ID3D11DeviceContext* context);
+    // Renders on the CPU into a premultiplied BGRA8 frame. threadCount <= 0 uses every hardware thread.
+    bool InitializeSoftware(int width, int height, int threadCount);
+    // Generates vertices on the CPU without rasterizing them and records per renderer type statistics.
+    bool InitializeCapture();
     void Shutdown();
 
     void SetSoundCallback(EffekseerForNative::LoadSoundFunc loadSound, EffekseerForNative::UnloadSoundFunc unloadSound, EffekseerForNative::PlaySoundFunc playSound);
@@ -21,8 +33,39 @@ public:
 
     void Update(float deltaSeconds);
     void Draw();
+    // Copies the last software-rendered frame into destinationHeight rows of destinationStride bytes, clipping
+    // whatever does not fit. Returns false when the software renderer is not in use.
+    bool CopySoftwareFrame(uint8_t* destination, int destinationStride, int destinationHeight) const;
+    int GetSoftwareFrameWidth() const;
+    int GetSoftwareFrameHeight() const;
+    // Vertices per second, bytes per frame and draw calls per frame for each renderer type.
+    std::wstring GetCaptureReport() const;
+    void ResetCaptureStatistics();
+    // The vertex stream of the last frame drawn in capture mode, or null outside it.
+    const std::vector<uint8_t>* GetCapturedVertexStream() const;
+    // Writes sprite, ribbon, ring and track vertices straight into the vertex buffer when a batch fits without
+    // wrapping it, instead of staging them and copying. Works with the DX11 and software renderers; on by default.
+    void SetDirectEmissionEnabled(bool enabled);
+    bool GetDirectEmissionEnabled() const;
+    // Ribbon and track trails with at least this many segments reuse the spline segments evaluated in the previous
+    // frame. 0 caches every trail and INT_MAX none; a negative count keeps the renderer's default.
+    void SetMinCachedSplineSegmentCount(int count);
+    int GetMinCachedSplineSegmentCount() const;
+    // Bytes per frame written directly, staged and copied, and the share of batches written directly.
+    std::wstring GetUploadReport() const;
+    void ResetUploadStatistics();
 
     bool LoadEffect(const std::wstring& key, const std::wstring& path);
+    // Reloads loaded effects from Update() when their files change, once a file has not changed for debounceMilliseconds.
+    // Playing instances keep their handles and are replayed to their current frame on the new data.
+    void EnableHotReload(bool enabled, int debounceMilliseconds = 300);
+    // What was reloaded or kept and how long each reload took, one line per reload.
+    std::wstring GetHotReloadReport() const;
+    // Attributes update time, instance updates, spawns, vertices and draw calls to the nodes of loaded effects.
+    void EnableNodeStatistics(bool enabled);
+    // The node tree of every loaded effect with per frame costs, followed by the heaviest nodes.
+    std::wstring GetNodeStatisticsReport(int heaviestCount = 5) const;
+    void ResetNodeStatistics();
     void PlayEffect(const std::wstring& key, float x, float y, float z = 0.0f);
 
     void StopAll();
@@ -37,11 +80,19 @@ public:
     void SetSpeed(float speed);
     void SetScale(float scale);
     void SetMaxDurationSeconds(int seconds);
+    // Caps the instances of the manager created by the next Initialize call. 0 means no limit: instance storage
+    // grows on demand, so dense effects are not truncated and small ones do not pay for a fixed reservation.
+    void SetInstanceLimit(int limit);
+    int GetInstanceLimit() const;
+    // Bytes the manager currently holds for instances, instance groups and containers.
+    size_t GetAllocatedInstanceBytes() const;
     const std::wstring& GetLastPlayedKey() const;
     int GetTotalFrame(const std::wstring& key) const;
     const std::wstring& GetLastErrorMessage() const;
 
 private:
+    bool InitializeManager();
+
     struct ActiveEffect
     {
         ::Effekseer::Handle handle = -1;
@@ -52,10 +103,17 @@ private:
 
 
     ::Effekseer::ManagerRef manager_;
-    ::EffekseerRendererDX11::RendererRef renderer_;
+    ::EffekseerRenderer::RendererRef renderer_;
+    EffekseerForNative::SoftwareRenderer* softwareRenderer_ = nullptr; // owned by renderer_
 
     std::unordered_map<std::wstring, ::Effekseer::EffectRef> effects_;
+    std::unordered_map<std::wstring, std::wstring> effectPaths_;
+    std::unique_ptr<EffekseerForNative::EffectHotReloader> hotReloader_;
     std::wstring lastPlayedKey_;
+    int64_t nodeStatisticsFrames_ = 0;
+    int64_t uploadFrames_ = 0;
+    bool directEmissionEnabled_ = true;
+    int minCachedSplineSegmentCount_ = -1;
 
     ::Effekseer::Matrix44 projection_;
     ::Effekseer::Matrix44 camera_;
@@ -71,6 +129,7 @@ private:
     float rotationY_ = 0.0f;
     float rotationZ_ = 0.0f;
     int maxDurationSeconds_ = 0;
+    int instanceLimit_ = 0;
     std::vector<ActiveEffect> active_;
     std::wstring lastErrorMessage_;
 };
@@ -0,0 +1,130 @@
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace EffekseerForNative
+{
+    MappedFileReaderRef MappedFileReader::Open(const std::filesystem::path& path)
+    {
+        MappedFileReaderRef reader(new MappedFileReader());
+
+#ifdef _WIN32
+        // Other processes may keep writing or replace the file; the mapping itself keeps the data alive.
+        auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return nullptr;
+
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(file, &size))
+        {
+            CloseHandle(file);
+            return nullptr;
+        }
+
+        if (size.QuadPart > 0)
+        {
+            // Copy-on-write so that a parser which writes into its input never reaches the file.
+            auto mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+            auto view = mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0) : nullptr;
+            if (mapping != nullptr) CloseHandle(mapping);
+            if (view == nullptr)
+            {
+                CloseHandle(file);
+                return nullptr;
+            }
+
+            reader->data_ = static_cast<const uint8_t*>(view);
+            reader->size_ = static_cast<size_t>(size.QuadPart);
+        }
+        CloseHandle(file);
+#else
+        auto file = open(path.c_str(), O_RDONLY);
+        if (file < 0) return nullptr;
+
+        struct stat status{};
+        if (fstat(file, &status) != 0)
+        {
+            close(file);
+            return nullptr;
+        }
+
+        if (status.st_size > 0)
+        {
+            auto view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+            if (view == MAP_FAILED)
+            {
+                close(file);
+                return nullptr;
+            }
+
+            reader->data_ = static_cast<const uint8_t*>(view);
+            reader->size_ = static_cast<size_t>(status.st_size);
+        }
+        close(file);
+#endif
+
+        return reader;
+    }
+
+    MappedFileReader::~MappedFileReader()
+    {
+        if (data_ == nullptr) return;
+
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+#else
+        munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+    }
+
+    size_t MappedFileReader::Read(void* buffer, size_t size)
+    {
+        auto count = (std::min)(size, size_ - position_);
+        if (count > 0)
+        {
+            std::memcpy(buffer, data_ + position_, count);
+            position_ += count;
+        }
+        return count;
+    }
+
+    void MappedFileReader::Seek(int position)
+    {
+        position_ = (std::min)(static_cast<size_t>((std::max)(position, 0)), size_);
+    }
+
+    int MappedFileReader::GetPosition() const
+    {
+        return static_cast<int>(position_);
+    }
+
+    size_t MappedFileReader::GetLength() const
+    {
+        return size_;
+    }
+
+    const void* MappedFileReader::GetData() const
+    {
+        return data_;
+    }
+
+    ::Effekseer::FileReaderRef MappedFileInterface::OpenRead(const char16_t* path)
+    {
+        return MappedFileReader::Open(std::filesystem::path(std::u16string(path)));
+    }
+
+    ::Effekseer::FileWriterRef MappedFileInterface::OpenWrite(const char16_t* path)
+    {
+        return defaultFileInterface_.OpenWrite(path);
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+// Memory-mapped reads for effects and their resources. The loaders ask the reader for its
+// data (FileReader::GetData) and parse or decode the mapped view in place, so a file is never
+// copied into an intermediate buffer; pages come straight from the file cache on first touch.
+
+#include <cstdint>
+#include <filesystem>
+
+#include <Effekseer.h>
+
+namespace EffekseerForNative
+{
+    class MappedFileReader;
+    using MappedFileReaderRef = ::Effekseer::RefPtr<MappedFileReader>;
+
+    // A copy-on-write view of a whole file. The view stays valid until the reader is released.
+    // On Windows nobody can truncate a mapped file, so readers are meant to be short-lived: they
+    // live for one load and are not used for files an exporter may be rewriting (see EffectHotReloader).
+    class MappedFileReader : public ::Effekseer::FileReader
+    {
+    public:
+        // Returns null when the file cannot be opened. An empty file gives a reader without data.
+        static MappedFileReaderRef Open(const std::filesystem::path& path);
+
+        ~MappedFileReader() override;
+
+        size_t Read(void* buffer, size_t size) override;
+        void Seek(int position) override;
+        int GetPosition() const override;
+        size_t GetLength() const override;
+        const void* GetData() const override;
+
+    private:
+        MappedFileReader() = default;
+
+        const uint8_t* data_ = nullptr;
+        size_t size_ = 0;
+        size_t position_ = 0;
+    };
+
+    class MappedFileInterface : public ::Effekseer::FileInterface
+    {
+    public:
+        ::Effekseer::FileReaderRef OpenRead(const char16_t* path) override;
+
+        // Writing is rare and small, so it goes through the default FILE* writer.
+        ::Effekseer::FileWriterRef OpenWrite(const char16_t* path) override;
+
+    private:
+        ::Effekseer::DefaultFileInterface defaultFileInterface_;
+    };
+}
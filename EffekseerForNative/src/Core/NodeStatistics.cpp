@@ -0,0 +1,134 @@
+#include "NodeStatistics.h"
+
+#include <algorithm>
+#include <cwchar>
+#include <filesystem>
+
+namespace
+{
+    void CollectNode(const std::wstring& key, ::Effekseer::EffectNode* node, const std::wstring& path, int32_t depth, std::vector<EffekseerForNative::NodeStatisticsEntry>& entries)
+    {
+        for (int i = 0; i < node->GetChildrenCount(); i++)
+        {
+            auto child = node->GetChild(i);
+            if (child == nullptr) continue;
+
+            EffekseerForNative::NodeStatisticsEntry entry;
+            entry.Key = key;
+            entry.Path = path.empty() ? std::to_wstring(i) : path + L"/" + std::to_wstring(i);
+            entry.Depth = depth;
+            entry.Type = child->GetType();
+            entry.Statistics = child->GetStatistics();
+            entries.push_back(entry);
+
+            CollectNode(key, child, entries.back().Path, depth + 1, entries);
+        }
+    }
+
+    void ResetNode(::Effekseer::EffectNode* node)
+    {
+        node->ResetStatistics();
+        for (int i = 0; i < node->GetChildrenCount(); i++)
+        {
+            if (node->GetChild(i) != nullptr) ResetNode(node->GetChild(i));
+        }
+    }
+}
+
+namespace EffekseerForNative
+{
+    void CollectNodeStatistics(const std::wstring& key, const ::Effekseer::EffectRef& effect, std::vector<NodeStatisticsEntry>& entries)
+    {
+        if (effect == nullptr || effect->GetRoot() == nullptr) return;
+
+        CollectNode(key, effect->GetRoot(), L"", 0, entries);
+    }
+
+    void ResetNodeStatistics(const ::Effekseer::EffectRef& effect)
+    {
+        if (effect == nullptr || effect->GetRoot() == nullptr) return;
+
+        ResetNode(effect->GetRoot());
+    }
+
+    std::wstring FormatNodeStatisticsReport(const std::vector<NodeStatisticsEntry>& entries, int64_t frameCount, int32_t heaviestCount)
+    {
+        if (entries.empty() || frameCount <= 0) return L"";
+
+        const auto frames = static_cast<double>(frameCount);
+        std::wstring report;
+        wchar_t line[512];
+        const std::wstring* lastKey = nullptr;
+        for (const auto& entry : entries)
+        {
+            if (lastKey == nullptr || *lastKey != entry.Key)
+            {
+                swprintf(line, sizeof(line) / sizeof(line[0]), L"%ls: per frame over %lld frames\n",
+                    std::filesystem::path(entry.Key).filename().wstring().c_str(),
+                    static_cast<long long>(frameCount));
+                report += line;
+                lastKey = &entry.Key;
+            }
+
+            const auto& statistics = entry.Statistics;
+            swprintf(line, sizeof(line) / sizeof(line[0]), L"%*ls%ls %ls: %.1f instance updates, %.2f spawns, %.1f us update, %.0f vertices, %.2f draw calls\n",
+                (entry.Depth + 1) * 2, L"",
+                entry.Path.c_str(),
+                GetNodeTypeName(entry.Type),
+                statistics.InstanceUpdates / frames,
+                statistics.Spawns / frames,
+                statistics.UpdateNanoseconds / frames / 1000.0,
+                statistics.Vertices / frames,
+                statistics.DrawCalls / frames);
+            report += line;
+        }
+
+        std::vector<const NodeStatisticsEntry*> heaviest;
+        for (const auto& entry : entries)
+        {
+            if (entry.Statistics.UpdateNanoseconds > 0 || entry.Statistics.Vertices > 0) heaviest.push_back(&entry);
+        }
+        std::stable_sort(heaviest.begin(), heaviest.end(), [](const NodeStatisticsEntry* a, const NodeStatisticsEntry* b)
+        {
+            if (a->Statistics.UpdateNanoseconds != b->Statistics.UpdateNanoseconds) return a->Statistics.UpdateNanoseconds > b->Statistics.UpdateNanoseconds;
+            return a->Statistics.Vertices > b->Statistics.Vertices;
+        });
+        if (heaviest.size() > static_cast<size_t>(std::max(heaviestCount, 0))) heaviest.resize(std::max(heaviestCount, 0));
+
+        if (!heaviest.empty())
+        {
+            report += L"Heaviest nodes:\n";
+            for (const auto* entry : heaviest)
+            {
+                swprintf(line, sizeof(line) / sizeof(line[0]), L"  %ls %ls %ls: %.1f us update, %.0f vertices, %.1f instance updates\n",
+                    std::filesystem::path(entry->Key).filename().wstring().c_str(),
+                    entry->Path.c_str(),
+                    GetNodeTypeName(entry->Type),
+                    entry->Statistics.UpdateNanoseconds / frames / 1000.0,
+                    entry->Statistics.Vertices / frames,
+                    entry->Statistics.InstanceUpdates / frames);
+                report += line;
+            }
+        }
+        return report;
+    }
+
+    const wchar_t* GetNodeTypeName(::Effekseer::EffectNodeType type)
+    {
+        switch (type)
+        {
+        case ::Effekseer::EffectNodeType::Sprite:
+            return L"Sprite";
+        case ::Effekseer::EffectNodeType::Ribbon:
+            return L"Ribbon";
+        case ::Effekseer::EffectNodeType::Ring:
+            return L"Ring";
+        case ::Effekseer::EffectNodeType::Model:
+            return L"Model";
+        case ::Effekseer::EffectNodeType::Track:
+            return L"Track";
+        default:
+            return L"None";
+        }
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+// Formats the per node costs the runtime collects while Manager::SetNodeStatisticsEnabled is on.
+// Runtime effects carry no node names, so nodes are identified by the child index of each level
+// from the root ("0/2" is the third child of the first node) and by their renderer type.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <Effekseer.h>
+
+namespace EffekseerForNative
+{
+    struct NodeStatisticsEntry
+    {
+        std::wstring Key;
+        std::wstring Path;
+        int32_t Depth = 0;
+        ::Effekseer::EffectNodeType Type = ::Effekseer::EffectNodeType::NoneType;
+        ::Effekseer::EffectNodeStatistics Statistics;
+    };
+
+    // Appends every node under the root of effect, depth first.
+    void CollectNodeStatistics(const std::wstring& key, const ::Effekseer::EffectRef& effect, std::vector<NodeStatisticsEntry>& entries);
+    void ResetNodeStatistics(const ::Effekseer::EffectRef& effect);
+
+    // The node tree with per frame averages over frameCount updates, followed by the heaviestCount
+    // nodes ordered by update time and then by vertices.
+    std::wstring FormatNodeStatisticsReport(const std::vector<NodeStatisticsEntry>& entries, int64_t frameCount, int32_t heaviestCount);
+
+    const wchar_t* GetNodeTypeName(::Effekseer::EffectNodeType type);
+}
@@ -0,0 +1,534 @@
+#include "SoftwareRasterizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    using EffekseerForNative::RasterTexture;
+    using EffekseerForNative::RasterVertex;
+
+    constexpr float Inv255 = 1.0f / 255.0f;
+
+    float Saturate(float value)
+    {
+        return std::min(std::max(value, 0.0f), 1.0f);
+    }
+
+    uint8_t ToUnorm8(float value)
+    {
+        return static_cast<uint8_t>(Saturate(value) * 255.0f + 0.5f);
+    }
+
+    int32_t WrapCoordinate(int32_t value, int32_t size, ::Effekseer::TextureWrapType wrap)
+    {
+        if (wrap == ::Effekseer::TextureWrapType::Repeat)
+        {
+            value %= size;
+            return value < 0 ? value + size : value;
+        }
+        return std::min(std::max(value, 0), size - 1);
+    }
+
+    void FetchTexel(const RasterTexture& texture, int32_t x, int32_t y, float* rgba)
+    {
+        const uint8_t* texel = texture.Pixels + (static_cast<size_t>(y) * texture.Width + x) * 4;
+        rgba[0] = texel[0] * Inv255;
+        rgba[1] = texel[1] * Inv255;
+        rgba[2] = texel[2] * Inv255;
+        rgba[3] = texel[3] * Inv255;
+    }
+
+    // Mirrors a D3D11 sampler with MIP level 0: texel centers at half-integer coordinates.
+    void Sample(const RasterTexture& texture, float u, float v, float* rgba)
+    {
+        if (texture.Pixels == nullptr)
+        {
+            rgba[0] = rgba[1] = rgba[2] = rgba[3] = 1.0f;
+            return;
+        }
+
+        if (texture.Wrap == ::Effekseer::TextureWrapType::Clamp)
+        {
+            u = Saturate(u);
+            v = Saturate(v);
+        }
+
+        float fx = u * texture.Width;
+        float fy = v * texture.Height;
+
+        if (texture.Filter == ::Effekseer::TextureFilterType::Nearest)
+        {
+            auto x = WrapCoordinate(static_cast<int32_t>(std::floor(fx)), texture.Width, texture.Wrap);
+            auto y = WrapCoordinate(static_cast<int32_t>(std::floor(fy)), texture.Height, texture.Wrap);
+            FetchTexel(texture, x, y, rgba);
+            return;
+        }
+
+        fx -= 0.5f;
+        fy -= 0.5f;
+        float bx = std::floor(fx);
+        float by = std::floor(fy);
+        float tx = fx - bx;
+        float ty = fy - by;
+
+        auto x0 = WrapCoordinate(static_cast<int32_t>(bx), texture.Width, texture.Wrap);
+        auto x1 = WrapCoordinate(static_cast<int32_t>(bx) + 1, texture.Width, texture.Wrap);
+        auto y0 = WrapCoordinate(static_cast<int32_t>(by), texture.Height, texture.Wrap);
+        auto y1 = WrapCoordinate(static_cast<int32_t>(by) + 1, texture.Height, texture.Wrap);
+
+        float c00[4], c10[4], c01[4], c11[4];
+        FetchTexel(texture, x0, y0, c00);
+        FetchTexel(texture, x1, y0, c10);
+        FetchTexel(texture, x0, y1, c01);
+        FetchTexel(texture, x1, y1, c11);
+
+        for (int32_t i = 0; i < 4; i++)
+        {
+            float top = c00[i] + (c10[i] - c00[i]) * tx;
+            float bottom = c01[i] + (c11[i] - c01[i]) * tx;
+            rgba[i] = top + (bottom - top) * ty;
+        }
+    }
+
+    RasterVertex Lerp(const RasterVertex& a, const RasterVertex& b, float t)
+    {
+        RasterVertex result;
+        for (int32_t i = 0; i < 4; i++)
+        {
+            result.Position[i] = a.Position[i] + (b.Position[i] - a.Position[i]) * t;
+        }
+        for (int32_t i = 0; i < RasterVertex::AttributeCount; i++)
+        {
+            result.Attributes[i] = a.Attributes[i] + (b.Attributes[i] - a.Attributes[i]) * t;
+        }
+        return result;
+    }
+
+    // Clips a triangle against the D3D near plane (z >= 0). Returns the vertex count of the resulting polygon.
+    int32_t ClipNear(const RasterVertex* input, RasterVertex* output)
+    {
+        int32_t count = 0;
+        for (int32_t i = 0; i < 3; i++)
+        {
+            const auto& current = input[i];
+            const auto& next = input[(i + 1) % 3];
+            float dc = current.Position[2];
+            float dn = next.Position[2];
+
+            if (dc >= 0.0f)
+            {
+                output[count++] = current;
+            }
+
+            if ((dc >= 0.0f) != (dn >= 0.0f))
+            {
+                output[count++] = Lerp(current, next, dc / (dc - dn));
+            }
+        }
+        return count;
+    }
+
+    // Fixed-function blend equations of the DX11 backend (see EffekseerRendererDX11::RenderState).
+    void BlendPixel(::Effekseer::AlphaBlendType blend, const float* src, uint8_t* dst)
+    {
+        float d[4] = {dst[2] * Inv255, dst[1] * Inv255, dst[0] * Inv255, dst[3] * Inv255};
+        float out[4];
+
+        switch (blend)
+        {
+        case ::Effekseer::AlphaBlendType::Opacity:
+            out[0] = src[0];
+            out[1] = src[1];
+            out[2] = src[2];
+            out[3] = std::max(src[3], d[3]);
+            break;
+        case ::Effekseer::AlphaBlendType::Add:
+            out[0] = d[0] + src[0] * src[3];
+            out[1] = d[1] + src[1] * src[3];
+            out[2] = d[2] + src[2] * src[3];
+            out[3] = d[3];
+            break;
+        case ::Effekseer::AlphaBlendType::Sub:
+            out[0] = d[0] - src[0] * src[3];
+            out[1] = d[1] - src[1] * src[3];
+            out[2] = d[2] - src[2] * src[3];
+            out[3] = d[3];
+            break;
+        case ::Effekseer::AlphaBlendType::Mul:
+            out[0] = d[0] * src[0];
+            out[1] = d[1] * src[1];
+            out[2] = d[2] * src[2];
+            out[3] = d[3];
+            break;
+        case ::Effekseer::AlphaBlendType::Blend:
+        default:
+            out[0] = src[0] * src[3] + d[0] * (1.0f - src[3]);
+            out[1] = src[1] * src[3] + d[1] * (1.0f - src[3]);
+            out[2] = src[2] * src[3] + d[2] * (1.0f - src[3]);
+            out[3] = src[3] + d[3] * (1.0f - src[3]);
+            break;
+        }
+
+        dst[0] = ToUnorm8(out[2]);
+        dst[1] = ToUnorm8(out[1]);
+        dst[2] = ToUnorm8(out[0]);
+        dst[3] = ToUnorm8(out[3]);
+    }
+}
+
+namespace EffekseerForNative
+{
+    SoftwareRasterizer::~SoftwareRasterizer()
+    {
+        Shutdown();
+    }
+
+    bool SoftwareRasterizer::Initialize(int32_t width, int32_t height, int32_t threadCount)
+    {
+        if (width <= 0 || height <= 0) return false;
+
+        Shutdown();
+
+        width_ = width;
+        height_ = height;
+        tilesX_ = (width + TileSize - 1) / TileSize;
+        tilesY_ = (height + TileSize - 1) / TileSize;
+
+        color_.assign(static_cast<size_t>(width) * height * 4, 0);
+        depth_.assign(static_cast<size_t>(width) * height, 1.0f);
+        bins_.assign(static_cast<size_t>(tilesX_) * tilesY_, {});
+
+        if (threadCount <= 0)
+        {
+            threadCount = std::max(1, static_cast<int32_t>(std::thread::hardware_concurrency()));
+        }
+
+        exiting_ = false;
+        for (int32_t i = 1; i < threadCount; i++)
+        {
+            workers_.emplace_back([this]() { WorkerLoop(); });
+        }
+        return true;
+    }
+
+    void SoftwareRasterizer::Shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            exiting_ = true;
+        }
+        wakeCondition_.notify_all();
+
+        for (auto& worker : workers_)
+        {
+            worker.join();
+        }
+        workers_.clear();
+    }
+
+    void SoftwareRasterizer::Clear()
+    {
+        std::fill(color_.begin(), color_.end(), static_cast<uint8_t>(0));
+        std::fill(depth_.begin(), depth_.end(), 1.0f);
+        triangles_.clear();
+        states_.clear();
+        for (auto& bin : bins_)
+        {
+            bin.clear();
+        }
+    }
+
+    int32_t SoftwareRasterizer::AddDrawState(const RasterDrawState& state)
+    {
+        states_.push_back(state);
+        return static_cast<int32_t>(states_.size()) - 1;
+    }
+
+    void SoftwareRasterizer::AddTriangle(int32_t stateIndex, const RasterVertex& v0, const RasterVertex& v1, const RasterVertex& v2)
+    {
+        const RasterVertex input[3] = {v0, v1, v2};
+
+        if (v0.Position[2] >= 0.0f && v1.Position[2] >= 0.0f && v2.Position[2] >= 0.0f)
+        {
+            SetupTriangle(stateIndex, v0, v1, v2);
+            return;
+        }
+
+        RasterVertex clipped[4];
+        auto count = ClipNear(input, clipped);
+        for (int32_t i = 1; i + 1 < count; i++)
+        {
+            SetupTriangle(stateIndex, clipped[0], clipped[i], clipped[i + 1]);
+        }
+    }
+
+    void SoftwareRasterizer::SetupTriangle(int32_t stateIndex, const RasterVertex& v0, const RasterVertex& v1, const RasterVertex& v2)
+    {
+        const RasterVertex* vertices[3] = {&v0, &v1, &v2};
+        float sx[3], sy[3], values[3][PlaneCount];
+
+        for (int32_t i = 0; i < 3; i++)
+        {
+            const auto& p = vertices[i]->Position;
+            if (p[3] <= 0.0f) return;
+
+            float invW = 1.0f / p[3];
+            sx[i] = (p[0] * invW * 0.5f + 0.5f) * width_;
+            sy[i] = (0.5f - p[1] * invW * 0.5f) * height_;
+            values[i][0] = p[2] * invW;
+            values[i][1] = invW;
+            for (int32_t a = 0; a < RasterVertex::AttributeCount; a++)
+            {
+                values[i][2 + a] = vertices[i]->Attributes[a] * invW;
+            }
+        }
+
+        float area = (sx[1] - sx[0]) * (sy[2] - sy[0]) - (sx[2] - sx[0]) * (sy[1] - sy[0]);
+        if (std::abs(area) < 1.0e-8f) return;
+
+        // Clockwise on screen is the front face, as with the DX11 rasterizer state.
+        const auto& state = states_[stateIndex];
+        if (state.Culling == ::Effekseer::CullingType::Front && area < 0.0f) return;
+        if (state.Culling == ::Effekseer::CullingType::Back && area > 0.0f) return;
+
+        int32_t order[3] = {0, 1, 2};
+        if (area < 0.0f)
+        {
+            std::swap(order[1], order[2]);
+            area = -area;
+        }
+
+        float minX = std::min({sx[0], sx[1], sx[2]});
+        float maxX = std::max({sx[0], sx[1], sx[2]});
+        float minY = std::min({sy[0], sy[1], sy[2]});
+        float maxY = std::max({sy[0], sy[1], sy[2]});
+        if (!std::isfinite(minX) || !std::isfinite(maxX) || !std::isfinite(minY) || !std::isfinite(maxY)) return;
+        if (maxX < 0.0f || maxY < 0.0f || minX > width_ || minY > height_) return;
+
+        // Vertices near the near plane project far outside the screen, so the bounds are clamped before they become integers.
+        const auto width = static_cast<float>(width_ - 1);
+        const auto height = static_cast<float>(height_ - 1);
+        Triangle triangle;
+        triangle.State = stateIndex;
+        triangle.MinX = static_cast<int32_t>(std::clamp(std::floor(minX), 0.0f, width));
+        triangle.MinY = static_cast<int32_t>(std::clamp(std::floor(minY), 0.0f, height));
+        triangle.MaxX = static_cast<int32_t>(std::clamp(std::ceil(maxX), 0.0f, width));
+        triangle.MaxY = static_cast<int32_t>(std::clamp(std::ceil(maxY), 0.0f, height));
+        if (triangle.MinX > triangle.MaxX || triangle.MinY > triangle.MaxY) return;
+
+        float x[3] = {sx[order[0]], sx[order[1]], sx[order[2]]};
+        float y[3] = {sy[order[0]], sy[order[1]], sy[order[2]]};
+
+        // Edge i runs from vertex i to vertex i + 1 and is positive inside.
+        for (int32_t i = 0; i < 3; i++)
+        {
+            int32_t j = (i + 1) % 3;
+            float dx = x[j] - x[i];
+            float dy = y[j] - y[i];
+            triangle.EdgeA[i] = -dy;
+            triangle.EdgeB[i] = dx;
+            triangle.EdgeC[i] = dy * x[i] - dx * y[i];
+            triangle.EdgeTopLeft[i] = dy < 0.0f || (dy == 0.0f && dx > 0.0f);
+        }
+
+        float invArea = 1.0f / area;
+        for (int32_t p = 0; p < PlaneCount; p++)
+        {
+            float c0 = values[order[0]][p];
+            float c1 = values[order[1]][p];
+            float c2 = values[order[2]][p];
+            float ddx = ((c1 - c0) * (y[2] - y[0]) - (c2 - c0) * (y[1] - y[0])) * invArea;
+            float ddy = ((c2 - c0) * (x[1] - x[0]) - (c1 - c0) * (x[2] - x[0])) * invArea;
+            triangle.Plane[p][0] = ddx;
+            triangle.Plane[p][1] = ddy;
+            triangle.Plane[p][2] = c0 - ddx * x[0] - ddy * y[0];
+        }
+
+        auto index = static_cast<uint32_t>(triangles_.size());
+        triangles_.push_back(triangle);
+
+        for (int32_t ty = triangle.MinY / TileSize; ty <= triangle.MaxY / TileSize; ty++)
+        {
+            for (int32_t tx = triangle.MinX / TileSize; tx <= triangle.MaxX / TileSize; tx++)
+            {
+                bins_[ty * tilesX_ + tx].push_back(index);
+            }
+        }
+    }
+
+    void SoftwareRasterizer::Flush()
+    {
+        if (triangles_.empty()) return;
+
+        RunTiles();
+
+        triangles_.clear();
+        states_.clear();
+        for (auto& bin : bins_)
+        {
+            bin.clear();
+        }
+    }
+
+    void SoftwareRasterizer::RunTiles()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            nextTile_ = 0;
+            busyWorkers_ = static_cast<int32_t>(workers_.size());
+            generation_++;
+        }
+        wakeCondition_.notify_all();
+
+        const int32_t tileCount = tilesX_ * tilesY_;
+        for (int32_t tile = nextTile_++; tile < tileCount; tile = nextTile_++)
+        {
+            RasterizeTile(tile);
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        doneCondition_.wait(lock, [this]() { return busyWorkers_ == 0; });
+    }
+
+    void SoftwareRasterizer::WorkerLoop()
+    {
+        uint64_t seenGeneration;
+        {
+            // A worker started after frames have run must not take the last generation for new work.
+            std::lock_guard<std::mutex> lock(mutex_);
+            seenGeneration = generation_;
+        }
+        const int32_t tileCount = tilesX_ * tilesY_;
+
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wakeCondition_.wait(lock, [&]() { return exiting_ || generation_ != seenGeneration; });
+                if (exiting_) return;
+                seenGeneration = generation_;
+            }
+
+            for (int32_t tile = nextTile_++; tile < tileCount; tile = nextTile_++)
+            {
+                RasterizeTile(tile);
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--busyWorkers_ == 0)
+            {
+                doneCondition_.notify_one();
+            }
+        }
+    }
+
+    void SoftwareRasterizer::RasterizeTile(int32_t tileIndex)
+    {
+        const auto& bin = bins_[tileIndex];
+        if (bin.empty()) return;
+
+        const int32_t tileX0 = (tileIndex % tilesX_) * TileSize;
+        const int32_t tileY0 = (tileIndex / tilesX_) * TileSize;
+        const int32_t tileX1 = std::min(tileX0 + TileSize, width_) - 1;
+        const int32_t tileY1 = std::min(tileY0 + TileSize, height_) - 1;
+
+        float values[PlaneCount];
+
+        for (auto triangleIndex : bin)
+        {
+            const auto& triangle = triangles_[triangleIndex];
+            const auto& state = states_[triangle.State];
+
+            const int32_t x0 = std::max(triangle.MinX, tileX0);
+            const int32_t x1 = std::min(triangle.MaxX, tileX1);
+            const int32_t y0 = std::max(triangle.MinY, tileY0);
+            const int32_t y1 = std::min(triangle.MaxY, tileY1);
+
+            for (int32_t py = y0; py <= y1; py++)
+            {
+                const float cy = py + 0.5f;
+                float edge[3];
+                for (int32_t i = 0; i < 3; i++)
+                {
+                    edge[i] = triangle.EdgeA[i] * (x0 + 0.5f) + triangle.EdgeB[i] * cy + triangle.EdgeC[i];
+                }
+
+                for (int32_t px = x0; px <= x1; px++, edge[0] += triangle.EdgeA[0], edge[1] += triangle.EdgeA[1], edge[2] += triangle.EdgeA[2])
+                {
+                    bool inside = true;
+                    for (int32_t i = 0; i < 3; i++)
+                    {
+                        if (edge[i] < 0.0f || (edge[i] == 0.0f && !triangle.EdgeTopLeft[i]))
+                        {
+                            inside = false;
+                            break;
+                        }
+                    }
+                    if (!inside) continue;
+
+                    const float cx = px + 0.5f;
+                    const size_t pixel = static_cast<size_t>(py) * width_ + px;
+
+                    float z = triangle.Plane[0][0] * cx + triangle.Plane[0][1] * cy + triangle.Plane[0][2];
+                    if (z < 0.0f || z > 1.0f) continue;
+                    if (state.DepthTest && z > depth_[pixel]) continue;
+
+                    float invW = triangle.Plane[1][0] * cx + triangle.Plane[1][1] * cy + triangle.Plane[1][2];
+                    if (invW <= 0.0f) continue;
+                    float w = 1.0f / invW;
+                    for (int32_t p = 2; p < PlaneCount; p++)
+                    {
+                        values[p] = (triangle.Plane[p][0] * cx + triangle.Plane[p][1] * cy + triangle.Plane[p][2]) * w;
+                    }
+
+                    const float* attributes = values + 2;
+                    float texel[4];
+                    Sample(state.ColorTexture, attributes[RasterVertex::UVIndex], attributes[RasterVertex::UVIndex + 1], texel);
+
+                    float color[4];
+                    for (int32_t i = 0; i < 4; i++)
+                    {
+                        color[i] = attributes[RasterVertex::ColorIndex + i] * texel[i];
+                    }
+
+                    if (state.IsLit)
+                    {
+                        const float* n = attributes + RasterVertex::NormalIndex;
+                        float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                        float diffuse = 0.0f;
+                        if (length > 0.0f)
+                        {
+                            diffuse = std::max(0.0f, (state.LightDirection[0] * n[0] + state.LightDirection[1] * n[1] + state.LightDirection[2] * n[2]) / length);
+                        }
+                        for (int32_t i = 0; i < 3; i++)
+                        {
+                            color[i] *= state.LightColor[i] * diffuse + state.LightAmbient[i];
+                        }
+                    }
+
+                    if (state.HasAlphaTexture)
+                    {
+                        float alphaTexel[4];
+                        Sample(state.AlphaTexture, attributes[RasterVertex::AlphaUVIndex], attributes[RasterVertex::AlphaUVIndex + 1], alphaTexel);
+                        color[3] *= alphaTexel[0] * alphaTexel[3];
+                    }
+
+                    color[0] *= state.EmissiveScaling;
+                    color[1] *= state.EmissiveScaling;
+                    color[2] *= state.EmissiveScaling;
+
+                    float threshold = state.HasAlphaThreshold ? std::max(0.0f, attributes[RasterVertex::AlphaThresholdIndex]) : 0.0f;
+                    if (color[3] <= threshold) continue;
+
+                    if (state.DepthTest && state.DepthWrite)
+                    {
+                        depth_[pixel] = z;
+                    }
+
+                    BlendPixel(state.Blend, color, color_.data() + pixel * 4);
+                }
+            }
+        }
+    }
+}
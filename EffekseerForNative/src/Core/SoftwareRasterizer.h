@@ -0,0 +1,123 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <Effekseer.h>
+
+namespace EffekseerForNative
+{
+    // Texture view sampled by the rasterizer. Pixels are RGBA8 with straight alpha.
+    struct RasterTexture
+    {
+        const uint8_t* Pixels = nullptr;
+        int32_t Width = 0;
+        int32_t Height = 0;
+        ::Effekseer::TextureFilterType Filter = ::Effekseer::TextureFilterType::Nearest;
+        ::Effekseer::TextureWrapType Wrap = ::Effekseer::TextureWrapType::Repeat;
+    };
+
+    // Fixed-function equivalent of the state a draw call binds on the GPU.
+    struct RasterDrawState
+    {
+        ::Effekseer::AlphaBlendType Blend = ::Effekseer::AlphaBlendType::Blend;
+        ::Effekseer::CullingType Culling = ::Effekseer::CullingType::Double;
+        bool DepthTest = false;
+        bool DepthWrite = false;
+        bool IsLit = false;
+        bool HasAlphaTexture = false;
+        bool HasAlphaThreshold = false;
+        RasterTexture ColorTexture;
+        RasterTexture AlphaTexture;
+        float EmissiveScaling = 1.0f;
+        float LightDirection[3] = {0.0f, 0.0f, 0.0f};
+        float LightColor[3] = {1.0f, 1.0f, 1.0f};
+        float LightAmbient[3] = {0.0f, 0.0f, 0.0f};
+    };
+
+    // Output of the vertex stage: clip-space position and the interpolated attributes.
+    struct RasterVertex
+    {
+        static constexpr int32_t ColorIndex = 0;
+        static constexpr int32_t UVIndex = 4;
+        static constexpr int32_t AlphaUVIndex = 6;
+        static constexpr int32_t AlphaThresholdIndex = 8;
+        static constexpr int32_t NormalIndex = 9;
+        static constexpr int32_t AttributeCount = 12;
+
+        float Position[4];
+        float Attributes[AttributeCount];
+    };
+
+    // Tile-binned triangle rasterizer writing premultiplied BGRA8.
+    // Triangles are set up and binned on the submitting thread; Flush() shades the tiles in parallel.
+    // Each tile keeps its triangles in submission order, so blending matches a GPU draw for draw.
+    class SoftwareRasterizer
+    {
+    public:
+        static constexpr int32_t TileSize = 64;
+
+        SoftwareRasterizer() = default;
+        ~SoftwareRasterizer();
+
+        SoftwareRasterizer(const SoftwareRasterizer&) = delete;
+        SoftwareRasterizer& operator=(const SoftwareRasterizer&) = delete;
+
+        bool Initialize(int32_t width, int32_t height, int32_t threadCount);
+        void Shutdown();
+
+        void Clear();
+        int32_t AddDrawState(const RasterDrawState& state);
+        void AddTriangle(int32_t stateIndex, const RasterVertex& v0, const RasterVertex& v1, const RasterVertex& v2);
+        void Flush();
+
+        const uint8_t* GetColorBuffer() const { return color_.data(); }
+        int32_t GetWidth() const { return width_; }
+        int32_t GetHeight() const { return height_; }
+        int32_t GetStride() const { return width_ * 4; }
+        int32_t GetThreadCount() const { return static_cast<int32_t>(workers_.size()) + 1; }
+
+    private:
+        static constexpr int32_t PlaneCount = 2 + RasterVertex::AttributeCount;
+
+        struct Triangle
+        {
+            int32_t State;
+            int32_t MinX, MinY, MaxX, MaxY;
+            float EdgeA[3], EdgeB[3], EdgeC[3];
+            bool EdgeTopLeft[3];
+
+            // Screen-space planes (dx, dy, c) for z, 1/w and every attribute divided by w.
+            float Plane[PlaneCount][3];
+        };
+
+        void SetupTriangle(int32_t stateIndex, const RasterVertex& v0, const RasterVertex& v1, const RasterVertex& v2);
+        void RasterizeTile(int32_t tileIndex);
+        void RunTiles();
+        void WorkerLoop();
+
+        int32_t width_ = 0;
+        int32_t height_ = 0;
+        int32_t tilesX_ = 0;
+        int32_t tilesY_ = 0;
+
+        std::vector<uint8_t> color_;
+        std::vector<float> depth_;
+        std::vector<RasterDrawState> states_;
+        std::vector<Triangle> triangles_;
+        std::vector<std::vector<uint32_t>> bins_;
+
+        std::vector<std::thread> workers_;
+        std::mutex mutex_;
+        std::condition_variable wakeCondition_;
+        std::condition_variable doneCondition_;
+        uint64_t generation_ = 0;
+        int32_t busyWorkers_ = 0;
+        bool exiting_ = false;
+        std::atomic<int32_t> nextTile_{0};
+    };
+}
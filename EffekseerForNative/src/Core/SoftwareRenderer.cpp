@@ -0,0 +1,1187 @@
+#include "SoftwareRenderer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+#include "../../vendor/effekseer/src/EffekseerRendererCommon/EffekseerRenderer.Renderer_Impl.h"
+#include "../../vendor/effekseer/src/EffekseerRendererCommon/EffekseerRenderer.RibbonRendererBase.h"
+#include "../../vendor/effekseer/src/EffekseerRendererCommon/EffekseerRenderer.RingRendererBase.h"
+#include "../../vendor/effekseer/src/EffekseerRendererCommon/EffekseerRenderer.SpriteRendererBase.h"
+#include "../../vendor/effekseer/src/EffekseerRendererCommon/EffekseerRenderer.TrackRendererBase.h"
+#include "../../vendor/effekseer/src/EffekseerRendererCommon/ModelLoader.h"
+#include "../../vendor/effekseer/src/EffekseerRendererCommon/TextureLoader.h"
+
+namespace
+{
+    using EffekseerForNative::RasterVertex;
+    using TextureFormatType = ::Effekseer::Backend::TextureFormatType;
+
+    constexpr float Inv255 = 1.0f / 255.0f;
+    constexpr int32_t ModelInstanceCount = 40;
+
+    using ModelVertexConstantBuffer = ::EffekseerRenderer::ModelRendererVertexConstantBuffer<ModelInstanceCount>;
+    using ModelAdvancedVertexConstantBuffer = ::EffekseerRenderer::ModelRendererAdvancedVertexConstantBuffer<ModelInstanceCount>;
+
+    // Row-vector transform, matching mul(matrix, position) in the HLSL shaders.
+    void TransformPoint(const float* position, const ::Effekseer::Matrix44& matrix, float* result)
+    {
+        for (int32_t c = 0; c < 4; c++)
+        {
+            result[c] = position[0] * matrix.Values[0][c] + position[1] * matrix.Values[1][c] + position[2] * matrix.Values[2][c] + position[3] * matrix.Values[3][c];
+        }
+    }
+
+    void StoreColor(const ::Effekseer::Color& color, const float* scale, float* attributes)
+    {
+        attributes[RasterVertex::ColorIndex + 0] = color.R * Inv255 * scale[0];
+        attributes[RasterVertex::ColorIndex + 1] = color.G * Inv255 * scale[1];
+        attributes[RasterVertex::ColorIndex + 2] = color.B * Inv255 * scale[2];
+        attributes[RasterVertex::ColorIndex + 3] = color.A * Inv255 * scale[3];
+    }
+
+    template <typename VERTEX, bool HasNormal, bool IsAdvanced>
+    void FetchSpriteVertex(const uint8_t* data, const ::EffekseerRenderer::StandardRendererVertexBuffer& vcb, RasterVertex& result)
+    {
+        static const float one[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+        const auto& v = *reinterpret_cast<const VERTEX*>(data);
+        const float position[4] = {v.Pos.X, v.Pos.Y, v.Pos.Z, 1.0f};
+        TransformPoint(position, vcb.constantVSBuffer[1], result.Position);
+
+        auto attributes = result.Attributes;
+        StoreColor(v.Col, one, attributes);
+        attributes[RasterVertex::UVIndex + 0] = v.UV[0];
+        attributes[RasterVertex::UVIndex + 1] = vcb.uvInversed[0] + vcb.uvInversed[1] * v.UV[1];
+
+        if constexpr (IsAdvanced)
+        {
+            attributes[RasterVertex::AlphaUVIndex + 0] = v.AlphaUV[0];
+            attributes[RasterVertex::AlphaUVIndex + 1] = vcb.uvInversed[0] + vcb.uvInversed[1] * v.AlphaUV[1];
+            attributes[RasterVertex::AlphaThresholdIndex] = v.AlphaThreshold;
+        }
+        else
+        {
+            attributes[RasterVertex::AlphaUVIndex + 0] = 0.0f;
+            attributes[RasterVertex::AlphaUVIndex + 1] = 0.0f;
+            attributes[RasterVertex::AlphaThresholdIndex] = 0.0f;
+        }
+
+        if constexpr (HasNormal)
+        {
+            attributes[RasterVertex::NormalIndex + 0] = (v.Normal.R * Inv255 - 0.5f) * 2.0f;
+            attributes[RasterVertex::NormalIndex + 1] = (v.Normal.G * Inv255 - 0.5f) * 2.0f;
+            attributes[RasterVertex::NormalIndex + 2] = (v.Normal.B * Inv255 - 0.5f) * 2.0f;
+        }
+        else
+        {
+            attributes[RasterVertex::NormalIndex + 0] = 0.0f;
+            attributes[RasterVertex::NormalIndex + 1] = 0.0f;
+            attributes[RasterVertex::NormalIndex + 2] = 0.0f;
+        }
+    }
+
+    template <typename VCB, bool IsAdvanced>
+    void FetchModelVertex(const uint8_t* data, const VCB& vcb, int32_t instance, RasterVertex& result)
+    {
+        const auto& v = *reinterpret_cast<const ::Effekseer::Model::Vertex*>(data);
+        const float position[4] = {v.Position.X, v.Position.Y, v.Position.Z, 1.0f};
+        float world[4];
+        TransformPoint(position, vcb.ModelMatrix[instance], world);
+        TransformPoint(world, vcb.CameraMatrix, result.Position);
+
+        auto attributes = result.Attributes;
+        StoreColor(v.VColor, vcb.ModelColor[instance], attributes);
+
+        const auto& uv = vcb.ModelUV[instance];
+        attributes[RasterVertex::UVIndex + 0] = v.UV.X * uv[2] + uv[0];
+        attributes[RasterVertex::UVIndex + 1] = vcb.UVInversed[0] + vcb.UVInversed[1] * (v.UV.Y * uv[3] + uv[1]);
+
+        if constexpr (IsAdvanced)
+        {
+            const auto& alphaUV = vcb.ModelAlphaUV[instance];
+            attributes[RasterVertex::AlphaUVIndex + 0] = v.UV.X * alphaUV[2] + alphaUV[0];
+            attributes[RasterVertex::AlphaUVIndex + 1] = vcb.UVInversed[0] + vcb.UVInversed[1] * (v.UV.Y * alphaUV[3] + alphaUV[1]);
+            attributes[RasterVertex::AlphaThresholdIndex] = vcb.ModelAlphaThreshold[instance][0];
+        }
+        else
+        {
+            attributes[RasterVertex::AlphaUVIndex + 0] = 0.0f;
+            attributes[RasterVertex::AlphaUVIndex + 1] = 0.0f;
+            attributes[RasterVertex::AlphaThresholdIndex] = 0.0f;
+        }
+
+        const auto& m = vcb.ModelMatrix[instance];
+        for (int32_t c = 0; c < 3; c++)
+        {
+            attributes[RasterVertex::NormalIndex + c] = v.Normal.X * m.Values[0][c] + v.Normal.Y * m.Values[1][c] + v.Normal.Z * m.Values[2][c];
+        }
+    }
+
+    uint32_t Expand565(uint16_t value, uint8_t* rgb)
+    {
+        rgb[0] = static_cast<uint8_t>(((value >> 11) & 31) * 255 / 31);
+        rgb[1] = static_cast<uint8_t>(((value >> 5) & 63) * 255 / 63);
+        rgb[2] = static_cast<uint8_t>((value & 31) * 255 / 31);
+        return value;
+    }
+
+    void DecodeColorBlock(const uint8_t* block, bool allowTransparent, uint8_t palette[4][4])
+    {
+        uint16_t c0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+        uint16_t c1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+        Expand565(c0, palette[0]);
+        Expand565(c1, palette[1]);
+        palette[0][3] = palette[1][3] = 255;
+
+        if (c0 > c1 || !allowTransparent)
+        {
+            for (int32_t i = 0; i < 3; i++)
+            {
+                palette[2][i] = static_cast<uint8_t>((2 * palette[0][i] + palette[1][i]) / 3);
+                palette[3][i] = static_cast<uint8_t>((palette[0][i] + 2 * palette[1][i]) / 3);
+            }
+            palette[2][3] = palette[3][3] = 255;
+        }
+        else
+        {
+            for (int32_t i = 0; i < 3; i++)
+            {
+                palette[2][i] = static_cast<uint8_t>((palette[0][i] + palette[1][i]) / 2);
+                palette[3][i] = 0;
+            }
+            palette[2][3] = 255;
+            palette[3][3] = 0;
+        }
+    }
+
+    // Decodes BC1/BC2/BC3 into RGBA8.
+    void DecodeBlockCompressed(TextureFormatType format, const uint8_t* src, int32_t width, int32_t height, uint8_t* dst)
+    {
+        const bool isBC1 = format == TextureFormatType::BC1 || format == TextureFormatType::BC1_SRGB;
+        const bool isBC2 = format == TextureFormatType::BC2 || format == TextureFormatType::BC2_SRGB;
+        const int32_t blockSize = isBC1 ? 8 : 16;
+        const int32_t blocksX = (width + 3) / 4;
+        const int32_t blocksY = (height + 3) / 4;
+
+        for (int32_t by = 0; by < blocksY; by++)
+        {
+            for (int32_t bx = 0; bx < blocksX; bx++)
+            {
+                const uint8_t* block = src + (static_cast<size_t>(by) * blocksX + bx) * blockSize;
+                const uint8_t* colorBlock = isBC1 ? block : block + 8;
+
+                uint8_t palette[4][4];
+                DecodeColorBlock(colorBlock, isBC1, palette);
+                uint32_t colorIndices = colorBlock[4] | (colorBlock[5] << 8) | (colorBlock[6] << 16) | (static_cast<uint32_t>(colorBlock[7]) << 24);
+
+                uint8_t alphas[16];
+                if (isBC2)
+                {
+                    for (int32_t i = 0; i < 16; i++)
+                    {
+                        uint8_t nibble = (block[i / 2] >> ((i % 2) * 4)) & 15;
+                        alphas[i] = static_cast<uint8_t>(nibble * 17);
+                    }
+                }
+                else if (!isBC1)
+                {
+                    uint8_t table[8];
+                    table[0] = block[0];
+                    table[1] = block[1];
+                    if (table[0] > table[1])
+                    {
+                        for (int32_t i = 1; i < 7; i++)
+                        {
+                            table[i + 1] = static_cast<uint8_t>(((7 - i) * table[0] + i * table[1]) / 7);
+                        }
+                    }
+                    else
+                    {
+                        for (int32_t i = 1; i < 5; i++)
+                        {
+                            table[i + 1] = static_cast<uint8_t>(((5 - i) * table[0] + i * table[1]) / 5);
+                        }
+                        table[6] = 0;
+                        table[7] = 255;
+                    }
+
+                    uint64_t bits = 0;
+                    for (int32_t i = 0; i < 6; i++)
+                    {
+                        bits |= static_cast<uint64_t>(block[2 + i]) << (8 * i);
+                    }
+                    for (int32_t i = 0; i < 16; i++)
+                    {
+                        alphas[i] = table[(bits >> (3 * i)) & 7];
+                    }
+                }
+
+                for (int32_t i = 0; i < 16; i++)
+                {
+                    int32_t x = bx * 4 + i % 4;
+                    int32_t y = by * 4 + i / 4;
+                    if (x >= width || y >= height) continue;
+
+                    const uint8_t* color = palette[(colorIndices >> (2 * i)) & 3];
+                    uint8_t* pixel = dst + (static_cast<size_t>(y) * width + x) * 4;
+                    pixel[0] = color[0];
+                    pixel[1] = color[1];
+                    pixel[2] = color[2];
+                    pixel[3] = isBC1 ? color[3] : alphas[i];
+                }
+            }
+        }
+    }
+
+    class CaptureScope
+    {
+        EffekseerForNative::SoftwareRenderer* renderer_;
+
+    public:
+        CaptureScope(EffekseerForNative::SoftwareRenderer* renderer, EffekseerForNative::VertexCaptureRendererType type)
+            : renderer_(renderer)
+        {
+            renderer_->BeginCaptureScope(type);
+        }
+
+        ~CaptureScope()
+        {
+            renderer_->EndCaptureScope();
+        }
+    };
+
+    // Node renderer that reports its renderer type to SoftwareRenderer while generating vertices.
+    template <typename BASE, EffekseerForNative::VertexCaptureRendererType Type>
+    class CapturingRenderer : public BASE
+    {
+    protected:
+        EffekseerForNative::SoftwareRenderer* captureRenderer_;
+
+    public:
+        CapturingRenderer(EffekseerForNative::SoftwareRenderer* renderer)
+            : BASE(renderer)
+            , captureRenderer_(renderer)
+        {
+        }
+
+        void BeginRendering(const typename BASE::NodeParameter& parameter, int32_t count, void* userData) override
+        {
+            CaptureScope scope(captureRenderer_, Type);
+            BASE::BeginRendering(parameter, count, userData);
+        }
+
+        void Rendering(const typename BASE::NodeParameter& parameter, const typename BASE::InstanceParameter& instanceParameter, void* userData) override
+        {
+            CaptureScope scope(captureRenderer_, Type);
+            BASE::Rendering(parameter, instanceParameter, userData);
+        }
+
+        void EndRendering(const typename BASE::NodeParameter& parameter, void* userData) override
+        {
+            CaptureScope scope(captureRenderer_, Type);
+            BASE::EndRendering(parameter, userData);
+        }
+    };
+
+    // Ribbons and tracks build their splines in the group callbacks.
+    template <typename BASE, EffekseerForNative::VertexCaptureRendererType Type>
+    class CapturingGroupRenderer : public CapturingRenderer<BASE, Type>
+    {
+    public:
+        using CapturingRenderer<BASE, Type>::CapturingRenderer;
+
+        void BeginRenderingGroup(const typename BASE::NodeParameter& parameter, int32_t count, void* userData) override
+        {
+            CaptureScope scope(this->captureRenderer_, Type);
+            BASE::BeginRenderingGroup(parameter, count, userData);
+        }
+
+        void EndRenderingGroup(const typename BASE::NodeParameter& parameter, int32_t count, void* userData) override
+        {
+            CaptureScope scope(this->captureRenderer_, Type);
+            BASE::EndRenderingGroup(parameter, count, userData);
+        }
+    };
+}
+
+namespace EffekseerForNative
+{
+    bool SoftwareTexture::Init(const ::Effekseer::Backend::TextureParameter& param, const ::Effekseer::CustomVector<uint8_t>& initialData)
+    {
+        param_ = param;
+        const int32_t width = param.Size[0];
+        const int32_t height = param.Size[1];
+        if (width <= 0 || height <= 0) return false;
+
+        const size_t pixelCount = static_cast<size_t>(width) * height;
+        pixels_.assign(pixelCount * 4, 0);
+        if (initialData.empty()) return true;
+
+        switch (param.Format)
+        {
+        case TextureFormatType::R8G8B8A8_UNORM:
+        case TextureFormatType::R8G8B8A8_UNORM_SRGB:
+            if (initialData.size() < pixelCount * 4) return false;
+            memcpy(pixels_.data(), initialData.data(), pixelCount * 4);
+            return true;
+        case TextureFormatType::B8G8R8A8_UNORM:
+        case TextureFormatType::B8G8R8A8_UNORM_SRGB:
+            if (initialData.size() < pixelCount * 4) return false;
+            for (size_t i = 0; i < pixelCount; i++)
+            {
+                pixels_[i * 4 + 0] = initialData[i * 4 + 2];
+                pixels_[i * 4 + 1] = initialData[i * 4 + 1];
+                pixels_[i * 4 + 2] = initialData[i * 4 + 0];
+                pixels_[i * 4 + 3] = initialData[i * 4 + 3];
+            }
+            return true;
+        case TextureFormatType::BC1:
+        case TextureFormatType::BC1_SRGB:
+        case TextureFormatType::BC2:
+        case TextureFormatType::BC2_SRGB:
+        case TextureFormatType::BC3:
+        case TextureFormatType::BC3_SRGB:
+        {
+            int32_t sizePerWidth = 0;
+            int32_t alignedHeight = 0;
+            ::EffekseerRenderer::CalculateAlignedTextureInformation(param.Format, {width, height}, sizePerWidth, alignedHeight);
+            if (initialData.size() < static_cast<size_t>(sizePerWidth) * alignedHeight) return false;
+            DecodeBlockCompressed(param.Format, initialData.data(), width, height, pixels_.data());
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+    RasterTexture SoftwareTexture::GetRasterTexture() const
+    {
+        RasterTexture texture;
+        texture.Pixels = pixels_.data();
+        texture.Width = param_.Size[0];
+        texture.Height = param_.Size[1];
+        return texture;
+    }
+
+    SoftwareBackendVertexBuffer::SoftwareBackendVertexBuffer(int32_t size, const void* initialData)
+        : data_(size)
+    {
+        if (initialData != nullptr)
+        {
+            memcpy(data_.data(), initialData, size);
+        }
+    }
+
+    void SoftwareBackendVertexBuffer::UpdateData(const void* src, int32_t size, int32_t offset)
+    {
+        assert(offset + size <= static_cast<int32_t>(data_.size()));
+        memcpy(data_.data() + offset, src, size);
+    }
+
+    SoftwareBackendIndexBuffer::SoftwareBackendIndexBuffer(int32_t elementCount, const void* initialData, ::Effekseer::Backend::IndexBufferStrideType stride)
+    {
+        strideType_ = stride;
+        elementCount_ = elementCount;
+        data_.resize(static_cast<size_t>(elementCount) * (stride == ::Effekseer::Backend::IndexBufferStrideType::Stride4 ? 4 : 2));
+        if (initialData != nullptr)
+        {
+            memcpy(data_.data(), initialData, data_.size());
+        }
+    }
+
+    void SoftwareBackendIndexBuffer::UpdateData(const void* src, int32_t size, int32_t offset)
+    {
+        assert(offset + size <= static_cast<int32_t>(data_.size()));
+        memcpy(data_.data() + offset, src, size);
+    }
+
+    ::Effekseer::Backend::VertexBufferRef SoftwareGraphicsDevice::CreateVertexBuffer(int32_t size, const void* initialData, bool /*isDynamic*/)
+    {
+        return ::Effekseer::MakeRefPtr<SoftwareBackendVertexBuffer>(size, initialData);
+    }
+
+    ::Effekseer::Backend::IndexBufferRef SoftwareGraphicsDevice::CreateIndexBuffer(int32_t elementCount, const void* initialData, ::Effekseer::Backend::IndexBufferStrideType stride)
+    {
+        return ::Effekseer::MakeRefPtr<SoftwareBackendIndexBuffer>(elementCount, initialData, stride);
+    }
+
+    bool SoftwareGraphicsDevice::UpdateVertexBuffer(::Effekseer::Backend::VertexBufferRef& buffer, int32_t size, int32_t offset, const void* data)
+    {
+        if (buffer == nullptr) return false;
+        buffer->UpdateData(data, size, offset);
+        return true;
+    }
+
+    bool SoftwareGraphicsDevice::UpdateIndexBuffer(::Effekseer::Backend::IndexBufferRef& buffer, int32_t size, int32_t offset, const void* data)
+    {
+        if (buffer == nullptr) return false;
+        buffer->UpdateData(data, size, offset);
+        return true;
+    }
+
+    ::Effekseer::Backend::TextureRef SoftwareGraphicsDevice::CreateTexture(const ::Effekseer::Backend::TextureParameter& param, const ::Effekseer::CustomVector<uint8_t>& initialData)
+    {
+        auto texture = ::Effekseer::MakeRefPtr<SoftwareTexture>();
+        if (!texture->Init(param, initialData))
+        {
+            return nullptr;
+        }
+        return texture;
+    }
+
+    SoftwareRingVertexBuffer::SoftwareRingVertexBuffer(int32_t size)
+        : VertexBufferBase(size, true)
+        , storage_(size)
+    {
+    }
+
+    void SoftwareRingVertexBuffer::Lock()
+    {
+        assert(!m_isLock);
+        assert(!ringBufferLock_);
+
+        m_isLock = true;
+        m_resource = storage_.data();
+        m_offset = 0;
+        m_vertexRingOffset = m_size;
+    }
+
+    bool SoftwareRingVertexBuffer::RingBufferLock(int32_t size, int32_t& offset, void*& data, int32_t alignment)
+    {
+        assert(!m_isLock);
+        assert(!ringBufferLock_);
+
+        if (size > m_size) return false;
+
+        m_vertexRingOffset = GetNextAliginedVertexRingOffset(m_vertexRingOffset, alignment);
+
+        if (RequireResetRing(m_vertexRingOffset, size, m_size))
+        {
+            offset = 0;
+            m_vertexRingOffset = size;
+        }
+        else
+        {
+            offset = m_vertexRingOffset;
+            m_vertexRingOffset += size;
+        }
+
+        // Nothing reads the ring asynchronously, so callers write straight into it.
+        m_resource = storage_.data();
+        data = storage_.data() + offset;
+        ringBufferLock_ = true;
+        return true;
+    }
+
+    bool SoftwareRingVertexBuffer::TryRingBufferLock(int32_t size, int32_t& offset, void*& data, int32_t alignment)
+    {
+        if (m_vertexRingOffset + size > m_size) return false;
+
+        return RingBufferLock(size, offset, data, alignment);
+    }
+
+    bool SoftwareRingVertexBuffer::ReserveRingBuffer(int32_t size, int32_t& offset, void*& data, int32_t alignment)
+    {
+        assert(!m_isLock);
+        assert(!ringBufferLock_);
+        assert(!ringBufferReserved_);
+
+        const auto alignedOffset = GetNextAliginedVertexRingOffset(m_vertexRingOffset, alignment);
+        if (RequireResetRing(alignedOffset, size, m_size)) return false;
+
+        // The whole tail stays reserved until the batch is flushed and its real size is known.
+        reservedOffset_ = alignedOffset;
+        m_vertexRingOffset = m_size;
+
+        m_resource = storage_.data();
+        offset = alignedOffset;
+        data = storage_.data() + alignedOffset;
+        ringBufferReserved_ = true;
+        return true;
+    }
+
+    void SoftwareRingVertexBuffer::CommitRingBuffer(int32_t size)
+    {
+        assert(ringBufferReserved_);
+        assert(reservedOffset_ + size <= m_size);
+
+        m_vertexRingOffset = reservedOffset_ + size;
+        m_resource = nullptr;
+        ringBufferReserved_ = false;
+    }
+
+    void SoftwareRingVertexBuffer::Unlock()
+    {
+        assert(m_isLock || ringBufferLock_);
+
+        m_resource = nullptr;
+        m_isLock = false;
+        ringBufferLock_ = false;
+    }
+
+    SoftwareQuadIndexBuffer::SoftwareQuadIndexBuffer(int32_t maxCount)
+        : IndexBufferBase(maxCount, false)
+        , storage_(static_cast<size_t>(maxCount) * 2)
+    {
+    }
+
+    void SoftwareQuadIndexBuffer::Lock()
+    {
+        assert(!m_isLock);
+
+        m_isLock = true;
+        m_resource = storage_.data();
+        m_indexCount = 0;
+    }
+
+    void SoftwareQuadIndexBuffer::Unlock()
+    {
+        assert(m_isLock);
+
+        m_resource = nullptr;
+        m_isLock = false;
+    }
+
+    void SoftwareRenderState::Update(bool /*forced*/)
+    {
+        m_active = m_next;
+    }
+
+    SoftwareShader::SoftwareShader(SoftwareVertexFormat format, bool isLit, bool isAdvanced, bool isDistortion)
+        : format_(format)
+        , isLit_(isLit)
+        , isAdvanced_(isAdvanced)
+        , isDistortion_(isDistortion)
+    {
+    }
+
+    void SoftwareShader::SetVertexConstantBufferSize(int32_t size)
+    {
+        vertexConstantBuffer_.assign(size, 0);
+    }
+
+    void SoftwareShader::SetPixelConstantBufferSize(int32_t size)
+    {
+        pixelConstantBuffer_.assign(size, 0);
+    }
+
+    SoftwareRendererRef SoftwareRenderer::Create(int32_t width, int32_t height, int32_t squareMaxCount, int32_t threadCount)
+    {
+        auto renderer = ::Effekseer::MakeRefPtr<SoftwareRenderer>(squareMaxCount);
+        if (!renderer->Initialize(width, height, threadCount))
+        {
+            return nullptr;
+        }
+        return renderer;
+    }
+
+    SoftwareRenderer::SoftwareRenderer(int32_t squareMaxCount)
+        : squareMaxCount_(squareMaxCount)
+    {
+    }
+
+    SoftwareRenderer::~SoftwareRenderer()
+    {
+        GetImpl()->DeleteProxyTextures(this);
+
+        ES_SAFE_DELETE(standardRenderer_);
+
+        ES_SAFE_DELETE(shaderUnlit_);
+        ES_SAFE_DELETE(shaderLit_);
+        ES_SAFE_DELETE(shaderDistortion_);
+        ES_SAFE_DELETE(shaderAdUnlit_);
+        ES_SAFE_DELETE(shaderAdLit_);
+        ES_SAFE_DELETE(shaderAdDistortion_);
+
+        ES_SAFE_DELETE(renderState_);
+        ES_SAFE_DELETE(vertexBuffer_);
+        ES_SAFE_DELETE(indexBuffer_);
+        ES_SAFE_DELETE(indexBufferForWireframe_);
+    }
+
+    bool SoftwareRenderer::Initialize(int32_t width, int32_t height, int32_t threadCount)
+    {
+        rasterizationEnabled_ = width > 0 && height > 0;
+        if (rasterizationEnabled_ && !rasterizer_.Initialize(width, height, threadCount)) return false;
+
+        graphicsDevice_ = ::Effekseer::MakeRefPtr<SoftwareGraphicsDevice>();
+
+        vertexBuffer_ = new SoftwareRingVertexBuffer(::EffekseerRenderer::GetMaximumVertexSizeInAllTypes() * squareMaxCount_ * 4);
+
+        // Same quad topology as the GPU backends (clockwise is the front face).
+        indexBuffer_ = new SoftwareQuadIndexBuffer(squareMaxCount_ * 6);
+        indexBuffer_->Lock();
+        for (int32_t i = 0; i < squareMaxCount_; i++)
+        {
+            uint16_t* buf = static_cast<uint16_t*>(indexBuffer_->GetBufferDirect(6));
+            buf[0] = static_cast<uint16_t>(3 + 4 * i);
+            buf[1] = static_cast<uint16_t>(1 + 4 * i);
+            buf[2] = static_cast<uint16_t>(0 + 4 * i);
+            buf[3] = static_cast<uint16_t>(3 + 4 * i);
+            buf[4] = static_cast<uint16_t>(0 + 4 * i);
+            buf[5] = static_cast<uint16_t>(2 + 4 * i);
+        }
+        indexBuffer_->Unlock();
+
+        indexBufferForWireframe_ = new SoftwareQuadIndexBuffer(squareMaxCount_ * 8);
+        indexBufferForWireframe_->Lock();
+        for (int32_t i = 0; i < squareMaxCount_; i++)
+        {
+            uint16_t* buf = static_cast<uint16_t*>(indexBufferForWireframe_->GetBufferDirect(8));
+            buf[0] = static_cast<uint16_t>(0 + 4 * i);
+            buf[1] = static_cast<uint16_t>(1 + 4 * i);
+            buf[2] = static_cast<uint16_t>(2 + 4 * i);
+            buf[3] = static_cast<uint16_t>(3 + 4 * i);
+            buf[4] = static_cast<uint16_t>(0 + 4 * i);
+            buf[5] = static_cast<uint16_t>(2 + 4 * i);
+            buf[6] = static_cast<uint16_t>(1 + 4 * i);
+            buf[7] = static_cast<uint16_t>(3 + 4 * i);
+        }
+        indexBufferForWireframe_->Unlock();
+
+        renderState_ = new SoftwareRenderState();
+
+        shaderUnlit_ = new SoftwareShader(SoftwareVertexFormat::Simple, false, false, false);
+        shaderLit_ = new SoftwareShader(SoftwareVertexFormat::Lighting, true, false, false);
+        shaderDistortion_ = new SoftwareShader(SoftwareVertexFormat::Lighting, false, false, true);
+        shaderAdUnlit_ = new SoftwareShader(SoftwareVertexFormat::AdvancedSimple, false, true, false);
+        shaderAdLit_ = new SoftwareShader(SoftwareVertexFormat::AdvancedLighting, true, true, false);
+        shaderAdDistortion_ = new SoftwareShader(SoftwareVertexFormat::AdvancedLighting, false, true, true);
+
+        for (auto shader : {shaderUnlit_, shaderLit_, shaderAdUnlit_, shaderAdLit_})
+        {
+            shader->SetVertexConstantBufferSize(sizeof(::EffekseerRenderer::StandardRendererVertexBuffer));
+            shader->SetPixelConstantBufferSize(sizeof(::EffekseerRenderer::PixelConstantBuffer));
+        }
+        for (auto shader : {shaderDistortion_, shaderAdDistortion_})
+        {
+            shader->SetVertexConstantBufferSize(sizeof(::EffekseerRenderer::StandardRendererVertexBuffer));
+            shader->SetPixelConstantBufferSize(sizeof(::EffekseerRenderer::PixelConstantBufferDistortion));
+        }
+
+        standardRenderer_ = new ::EffekseerRenderer::StandardRenderer<SoftwareRenderer, SoftwareShader>(this);
+
+        GetImpl()->CreateProxyTextures(this);
+
+        return true;
+    }
+
+    bool SoftwareRenderer::BeginRendering()
+    {
+        impl->CalculateCameraProjectionMatrix();
+
+        renderState_->GetActiveState().Reset();
+        renderState_->Update(true);
+
+        if (rasterizationEnabled_)
+        {
+            rasterizer_.Clear();
+        }
+
+        if (capture_ != nullptr)
+        {
+            capture_->BeginFrame();
+        }
+
+        standardRenderer_->ResetAndRenderingIfRequired();
+        frameUploadBegin_ = standardRenderer_->GetStatistics();
+
+        return true;
+    }
+
+    bool SoftwareRenderer::EndRendering()
+    {
+        BeginCaptureScope(captureType_);
+        standardRenderer_->ResetAndRenderingIfRequired();
+        EndCaptureScope();
+
+        if (rasterizationEnabled_)
+        {
+            rasterizer_.Flush();
+        }
+        frameTextures_.clear();
+
+        if (capture_ != nullptr)
+        {
+            // The statistics keep accumulating for GetStandardRendererStatistics, so only this frame's share goes to the capture
+            const auto& upload = standardRenderer_->GetStatistics();
+            capture_->AddUpload(upload.DirectBytes - frameUploadBegin_.DirectBytes,
+                upload.StagedBytes - frameUploadBegin_.StagedBytes,
+                upload.CopiedBytes - frameUploadBegin_.CopiedBytes);
+            capture_->EndFrame();
+        }
+
+        return true;
+    }
+
+    ::Effekseer::SpriteRendererRef SoftwareRenderer::CreateSpriteRenderer()
+    {
+        return ::Effekseer::SpriteRendererRef(new CapturingRenderer<::EffekseerRenderer::SpriteRendererBase<SoftwareRenderer, false>, VertexCaptureRendererType::Sprite>(this));
+    }
+
+    ::Effekseer::RibbonRendererRef SoftwareRenderer::CreateRibbonRenderer()
+    {
+        return ::Effekseer::RibbonRendererRef(new CapturingGroupRenderer<::EffekseerRenderer::RibbonRendererBase<SoftwareRenderer, false>, VertexCaptureRendererType::Ribbon>(this));
+    }
+
+    ::Effekseer::RingRendererRef SoftwareRenderer::CreateRingRenderer()
+    {
+        return ::Effekseer::RingRendererRef(new CapturingRenderer<::EffekseerRenderer::RingRendererBase<SoftwareRenderer, false>, VertexCaptureRendererType::Ring>(this));
+    }
+
+    ::Effekseer::ModelRendererRef SoftwareRenderer::CreateModelRenderer()
+    {
+        return SoftwareModelRenderer::Create(SoftwareRendererRef::FromPinned(this));
+    }
+
+    ::Effekseer::TrackRendererRef SoftwareRenderer::CreateTrackRenderer()
+    {
+        return ::Effekseer::TrackRendererRef(new CapturingGroupRenderer<::EffekseerRenderer::TrackRendererBase<SoftwareRenderer, false>, VertexCaptureRendererType::Track>(this));
+    }
+
+    ::Effekseer::TextureLoaderRef SoftwareRenderer::CreateTextureLoader(::Effekseer::FileInterfaceRef fileInterface)
+    {
+        return ::EffekseerRenderer::CreateTextureLoader(graphicsDevice_, fileInterface, ::Effekseer::ColorSpaceType::Gamma);
+    }
+
+    ::Effekseer::ModelLoaderRef SoftwareRenderer::CreateModelLoader(::Effekseer::FileInterfaceRef fileInterface)
+    {
+        return ::Effekseer::MakeRefPtr<::EffekseerRenderer::ModelLoader>(graphicsDevice_, fileInterface);
+    }
+
+    void SoftwareRenderer::ResetRenderState()
+    {
+        renderState_->GetActiveState().Reset();
+        renderState_->Update(true);
+    }
+
+    void SoftwareRenderer::SetDistortingCallback(::EffekseerRenderer::DistortingCallback* callback)
+    {
+        // Distortion needs a captured background, which a CPU frame never provides.
+        ES_SAFE_DELETE(callback);
+    }
+
+    ::Effekseer::Backend::GraphicsDeviceRef SoftwareRenderer::GetGraphicsDevice() const
+    {
+        return graphicsDevice_;
+    }
+
+    SoftwareQuadIndexBuffer* SoftwareRenderer::GetIndexBuffer()
+    {
+        if (GetRenderMode() == ::Effekseer::RenderMode::Wireframe)
+        {
+            return indexBufferForWireframe_;
+        }
+        return indexBuffer_;
+    }
+
+    void SoftwareRenderer::SetVertexBuffer(SoftwareRingVertexBuffer* vertexBuffer, int32_t stride)
+    {
+        boundVertices_ = vertexBuffer->GetData();
+        boundVerticesStatic_ = false;
+        boundStride_ = stride;
+    }
+
+    void SoftwareRenderer::SetVertexBuffer(const ::Effekseer::Backend::VertexBufferRef& vertexBuffer, int32_t stride)
+    {
+        boundVertices_ = static_cast<SoftwareBackendVertexBuffer*>(vertexBuffer.Get())->GetData();
+        boundVerticesStatic_ = true;
+        boundStride_ = stride;
+    }
+
+    void SoftwareRenderer::SetIndexBuffer(SoftwareQuadIndexBuffer* indexBuffer)
+    {
+        boundIndices_ = reinterpret_cast<const uint8_t*>(indexBuffer->GetData());
+        boundIndexStride_ = 2;
+    }
+
+    void SoftwareRenderer::SetIndexBuffer(const ::Effekseer::Backend::IndexBufferRef& indexBuffer)
+    {
+        auto buffer = static_cast<SoftwareBackendIndexBuffer*>(indexBuffer.Get());
+        boundIndices_ = buffer->GetData();
+        boundIndexStride_ = buffer->GetStrideType() == ::Effekseer::Backend::IndexBufferStrideType::Stride4 ? 4 : 2;
+    }
+
+    void SoftwareRenderer::DrawSprites(int32_t spriteCount, int32_t vertexOffset)
+    {
+        impl->drawcallCount++;
+        impl->drawvertexCount += spriteCount * 4;
+
+        const auto isWireframe = GetRenderMode() == ::Effekseer::RenderMode::Wireframe;
+        if (capture_ != nullptr)
+        {
+            CaptureDraw(boundVertices_ + static_cast<size_t>(vertexOffset) * boundStride_, spriteCount * 4, spriteCount * (isWireframe ? 8 : 6), 1);
+        }
+
+        if (!rasterizationEnabled_ || isWireframe) return;
+
+        auto stateIndex = AddDrawState();
+        if (stateIndex < 0) return;
+
+        const uint8_t* vertices = boundVertices_;
+        boundVertices_ += static_cast<size_t>(vertexOffset) * boundStride_;
+        TransformVertices(spriteCount * 4, 0);
+        boundVertices_ = vertices;
+
+        SubmitTriangles(stateIndex, spriteCount * 6, 0);
+    }
+
+    void SoftwareRenderer::DrawPolygon(int32_t vertexCount, int32_t indexCount)
+    {
+        impl->drawcallCount++;
+        impl->drawvertexCount += vertexCount;
+
+        if (capture_ != nullptr)
+        {
+            CaptureDraw(boundVertices_, vertexCount, indexCount, 1);
+        }
+
+        if (!rasterizationEnabled_ || GetRenderMode() != ::Effekseer::RenderMode::Normal) return;
+
+        auto stateIndex = AddDrawState();
+        if (stateIndex < 0) return;
+
+        TransformVertices(vertexCount, 0);
+        SubmitTriangles(stateIndex, indexCount, 0);
+    }
+
+    void SoftwareRenderer::DrawPolygonInstanced(int32_t vertexCount, int32_t indexCount, int32_t instanceCount)
+    {
+        impl->drawcallCount++;
+        impl->drawvertexCount += vertexCount * instanceCount;
+
+        if (capture_ != nullptr)
+        {
+            CaptureDraw(boundVertices_, vertexCount, indexCount, instanceCount);
+        }
+
+        if (!rasterizationEnabled_ || GetRenderMode() != ::Effekseer::RenderMode::Normal) return;
+
+        auto stateIndex = AddDrawState();
+        if (stateIndex < 0) return;
+
+        for (int32_t instance = 0; instance < instanceCount; instance++)
+        {
+            TransformVertices(vertexCount, instance);
+            SubmitTriangles(stateIndex, indexCount, 0);
+        }
+    }
+
+    int32_t SoftwareRenderer::AddDrawState()
+    {
+        auto shader = currentShader_;
+        if (shader == nullptr || shader->GetIsDistortion()) return -1;
+
+        const auto& active = renderState_->GetActiveState();
+        RasterDrawState state;
+        state.Blend = active.AlphaBlend;
+        state.Culling = active.CullingType;
+        state.DepthTest = active.DepthTest;
+        state.DepthWrite = active.DepthWrite;
+        state.IsLit = shader->GetIsLit();
+        state.HasAlphaThreshold = shader->GetIsAdvanced();
+
+        auto bindTexture = [&](int32_t slot, RasterTexture& target) {
+            if (slot >= boundTextureCount_ || boundTextures_[slot] == nullptr) return false;
+            target = static_cast<SoftwareTexture*>(boundTextures_[slot].Get())->GetRasterTexture();
+            target.Filter = active.TextureFilterTypes[slot];
+            target.Wrap = active.TextureWrapTypes[slot];
+            frameTextures_.push_back(boundTextures_[slot]);
+            return true;
+        };
+
+        bindTexture(0, state.ColorTexture);
+        if (shader->GetIsAdvanced())
+        {
+            // The alpha texture follows the normal map when lighting is enabled.
+            state.HasAlphaTexture = bindTexture(shader->GetIsLit() ? 2 : 1, state.AlphaTexture);
+        }
+
+        const auto& pcb = *static_cast<const ::EffekseerRenderer::PixelConstantBuffer*>(shader->GetPixelConstantBuffer());
+        state.EmissiveScaling = pcb.EmmisiveParam.EmissiveScaling;
+        for (int32_t i = 0; i < 3; i++)
+        {
+            state.LightDirection[i] = pcb.LightDirection[i];
+            state.LightColor[i] = pcb.LightColor[i];
+            state.LightAmbient[i] = pcb.LightAmbientColor[i];
+        }
+
+        return rasterizer_.AddDrawState(state);
+    }
+
+    void SoftwareRenderer::TransformVertices(int32_t vertexCount, int32_t instanceIndex)
+    {
+        transformed_.resize(vertexCount);
+
+        const auto shader = currentShader_;
+        const uint8_t* vcb = static_cast<const uint8_t*>(shader->GetVertexConstantBuffer());
+        const auto& spriteVcb = *reinterpret_cast<const ::EffekseerRenderer::StandardRendererVertexBuffer*>(vcb);
+
+        for (int32_t i = 0; i < vertexCount; i++)
+        {
+            const uint8_t* vertex = boundVertices_ + static_cast<size_t>(i) * boundStride_;
+            auto& result = transformed_[i];
+
+            switch (shader->GetFormat())
+            {
+            case SoftwareVertexFormat::Simple:
+                FetchSpriteVertex<::EffekseerRenderer::SimpleVertex, false, false>(vertex, spriteVcb, result);
+                break;
+            case SoftwareVertexFormat::Lighting:
+                FetchSpriteVertex<::EffekseerRenderer::LightingVertex, true, false>(vertex, spriteVcb, result);
+                break;
+            case SoftwareVertexFormat::AdvancedSimple:
+                FetchSpriteVertex<::EffekseerRenderer::AdvancedSimpleVertex, false, true>(vertex, spriteVcb, result);
+                break;
+            case SoftwareVertexFormat::AdvancedLighting:
+                FetchSpriteVertex<::EffekseerRenderer::AdvancedLightingVertex, true, true>(vertex, spriteVcb, result);
+                break;
+            case SoftwareVertexFormat::Model:
+                if (shader->GetIsAdvanced())
+                {
+                    FetchModelVertex<ModelAdvancedVertexConstantBuffer, true>(vertex, *reinterpret_cast<const ModelAdvancedVertexConstantBuffer*>(vcb), instanceIndex, result);
+                }
+                else
+                {
+                    FetchModelVertex<ModelVertexConstantBuffer, false>(vertex, *reinterpret_cast<const ModelVertexConstantBuffer*>(vcb), instanceIndex, result);
+                }
+                break;
+            }
+        }
+    }
+
+    void SoftwareRenderer::SubmitTriangles(int32_t stateIndex, int32_t indexCount, int32_t vertexBase)
+    {
+        const auto vertexCount = static_cast<uint32_t>(transformed_.size());
+
+        for (int32_t i = 0; i + 2 < indexCount; i += 3)
+        {
+            uint32_t index[3];
+            for (int32_t k = 0; k < 3; k++)
+            {
+                const uint8_t* p = boundIndices_ + static_cast<size_t>(i + k) * boundIndexStride_;
+                index[k] = (boundIndexStride_ == 4 ? *reinterpret_cast<const uint32_t*>(p) : *reinterpret_cast<const uint16_t*>(p)) - vertexBase;
+            }
+
+            if (index[0] >= vertexCount || index[1] >= vertexCount || index[2] >= vertexCount) continue;
+
+            rasterizer_.AddTriangle(stateIndex, transformed_[index[0]], transformed_[index[1]], transformed_[index[2]]);
+        }
+    }
+
+    void SoftwareRenderer::CaptureDraw(const uint8_t* vertices, int32_t vertexCount, int32_t indexCount, int32_t instanceCount)
+    {
+        VertexCaptureDrawInput input;
+        input.Vertices = boundVerticesStatic_ ? nullptr : vertices;
+        input.VertexCount = vertexCount;
+        input.Stride = boundStride_;
+        input.Indices = boundIndices_;
+        input.IndexCount = indexCount;
+        input.IndexStride = boundIndexStride_;
+        input.InstanceCount = instanceCount;
+
+        // Model index buffers are static like their vertices; only the quad index pattern is worth recording.
+        if (boundVerticesStatic_)
+        {
+            input.Indices = nullptr;
+        }
+
+        if (currentShader_ != nullptr)
+        {
+            input.VertexUniforms = currentShader_->GetVertexConstantBuffer();
+            input.VertexUniformSize = currentShader_->GetVertexConstantBufferSize();
+            input.PixelUniforms = currentShader_->GetPixelConstantBuffer();
+            input.PixelUniformSize = currentShader_->GetPixelConstantBufferSize();
+        }
+
+        capture_->RecordDraw(captureType_, input);
+    }
+
+    void SoftwareRenderer::EnableVertexCapture()
+    {
+        if (capture_ == nullptr)
+        {
+            capture_ = std::make_unique<VertexCapture>();
+        }
+    }
+
+    void SoftwareRenderer::BeginCaptureScope(VertexCaptureRendererType type)
+    {
+        if (capture_ == nullptr) return;
+
+        if (type != captureType_)
+        {
+            // Pending batches were generated by the previous type; submit them under that type.
+            const auto start = std::chrono::steady_clock::now();
+            standardRenderer_->ResetAndRenderingIfRequired();
+            capture_->AddGenerationTime(captureType_, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+            captureType_ = type;
+        }
+
+        captureScopeStart_ = std::chrono::steady_clock::now();
+    }
+
+    void SoftwareRenderer::EndCaptureScope()
+    {
+        if (capture_ == nullptr) return;
+
+        capture_->AddGenerationTime(captureType_, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - captureScopeStart_).count());
+    }
+
+    SoftwareShader* SoftwareRenderer::GetShader(::EffekseerRenderer::RendererShaderType type) const
+    {
+        switch (type)
+        {
+        case ::EffekseerRenderer::RendererShaderType::AdvancedBackDistortion:
+            return shaderAdDistortion_;
+        case ::EffekseerRenderer::RendererShaderType::AdvancedLit:
+            return shaderAdLit_;
+        case ::EffekseerRenderer::RendererShaderType::AdvancedUnlit:
+            return shaderAdUnlit_;
+        case ::EffekseerRenderer::RendererShaderType::BackDistortion:
+            return shaderDistortion_;
+        case ::EffekseerRenderer::RendererShaderType::Lit:
+            return shaderLit_;
+        case ::EffekseerRenderer::RendererShaderType::Unlit:
+            return shaderUnlit_;
+        default:
+            assert(0);
+            return nullptr;
+        }
+    }
+
+    void SoftwareRenderer::BeginShader(SoftwareShader* shader)
+    {
+        currentShader_ = shader;
+    }
+
+    void SoftwareRenderer::EndShader(SoftwareShader* /*shader*/)
+    {
+        currentShader_ = nullptr;
+    }
+
+    void SoftwareRenderer::SetVertexBufferToShader(const void* data, int32_t size, int32_t dstOffset)
+    {
+        assert(currentShader_ != nullptr);
+        assert(currentShader_->GetVertexConstantBufferSize() >= size + dstOffset);
+
+        auto p = static_cast<uint8_t*>(currentShader_->GetVertexConstantBuffer()) + dstOffset;
+        memcpy(p, data, size);
+    }
+
+    void SoftwareRenderer::SetPixelBufferToShader(const void* data, int32_t size, int32_t dstOffset)
+    {
+        assert(currentShader_ != nullptr);
+        assert(currentShader_->GetPixelConstantBufferSize() >= size + dstOffset);
+
+        auto p = static_cast<uint8_t*>(currentShader_->GetPixelConstantBuffer()) + dstOffset;
+        memcpy(p, data, size);
+    }
+
+    void SoftwareRenderer::SetTextures(SoftwareShader* /*shader*/, ::Effekseer::Backend::TextureRef* textures, int32_t count)
+    {
+        boundTextureCount_ = std::min(count, static_cast<int32_t>(boundTextures_.size()));
+        for (int32_t i = 0; i < boundTextureCount_; i++)
+        {
+            boundTextures_[i] = textures[i];
+        }
+    }
+
+    SoftwareModelRenderer::SoftwareModelRenderer(const SoftwareRendererRef& renderer)
+        : renderer_(renderer)
+    {
+        shaderAdvancedLit_ = new SoftwareShader(SoftwareVertexFormat::Model, true, true, false);
+        shaderAdvancedUnlit_ = new SoftwareShader(SoftwareVertexFormat::Model, false, true, false);
+        shaderAdvancedDistortion_ = new SoftwareShader(SoftwareVertexFormat::Model, false, true, true);
+        shaderLit_ = new SoftwareShader(SoftwareVertexFormat::Model, true, false, false);
+        shaderUnlit_ = new SoftwareShader(SoftwareVertexFormat::Model, false, false, false);
+        shaderDistortion_ = new SoftwareShader(SoftwareVertexFormat::Model, false, false, true);
+
+        for (auto shader : {shaderAdvancedLit_, shaderAdvancedUnlit_})
+        {
+            shader->SetVertexConstantBufferSize(sizeof(ModelAdvancedVertexConstantBuffer));
+            shader->SetPixelConstantBufferSize(sizeof(::EffekseerRenderer::PixelConstantBuffer));
+        }
+        shaderAdvancedDistortion_->SetVertexConstantBufferSize(sizeof(ModelAdvancedVertexConstantBuffer));
+        shaderAdvancedDistortion_->SetPixelConstantBufferSize(sizeof(::EffekseerRenderer::PixelConstantBufferDistortion));
+
+        for (auto shader : {shaderLit_, shaderUnlit_})
+        {
+            shader->SetVertexConstantBufferSize(sizeof(ModelVertexConstantBuffer));
+            shader->SetPixelConstantBufferSize(sizeof(::EffekseerRenderer::PixelConstantBuffer));
+        }
+        shaderDistortion_->SetVertexConstantBufferSize(sizeof(ModelVertexConstantBuffer));
+        shaderDistortion_->SetPixelConstantBufferSize(sizeof(::EffekseerRenderer::PixelConstantBufferDistortion));
+
+        VertexType = ::EffekseerRenderer::ModelRendererVertexType::Instancing;
+    }
+
+    SoftwareModelRenderer::~SoftwareModelRenderer()
+    {
+        ES_SAFE_DELETE(shaderAdvancedLit_);
+        ES_SAFE_DELETE(shaderAdvancedUnlit_);
+        ES_SAFE_DELETE(shaderAdvancedDistortion_);
+        ES_SAFE_DELETE(shaderLit_);
+        ES_SAFE_DELETE(shaderUnlit_);
+        ES_SAFE_DELETE(shaderDistortion_);
+    }
+
+    SoftwareModelRendererRef SoftwareModelRenderer::Create(const SoftwareRendererRef& renderer)
+    {
+        assert(renderer != nullptr);
+        return SoftwareModelRendererRef(new SoftwareModelRenderer(renderer));
+    }
+
+    void SoftwareModelRenderer::BeginRendering(const NodeParameter& parameter, int32_t count, void* userData)
+    {
+        CaptureScope scope(renderer_.Get(), VertexCaptureRendererType::Model);
+        BeginRendering_(renderer_.Get(), parameter, count, userData);
+    }
+
+    void SoftwareModelRenderer::Rendering(const NodeParameter& parameter, const InstanceParameter& instanceParameter, void* userData)
+    {
+        CaptureScope scope(renderer_.Get(), VertexCaptureRendererType::Model);
+        Rendering_<SoftwareRenderer>(renderer_.Get(), parameter, instanceParameter, userData);
+    }
+
+    void SoftwareModelRenderer::EndRendering(const NodeParameter& parameter, void* userData)
+    {
+        if (parameter.ModelIndex < 0) return;
+
+        CaptureScope scope(renderer_.Get(), VertexCaptureRendererType::Model);
+
+        ::Effekseer::ModelRef model = nullptr;
+        if (parameter.IsProceduralMode)
+        {
+            model = parameter.EffectPointer->GetProceduralModel(parameter.ModelIndex);
+        }
+        else
+        {
+            model = parameter.EffectPointer->GetModel(parameter.ModelIndex);
+        }
+
+        if (model == nullptr) return;
+
+        auto graphicsDevice = renderer_->GetGraphicsDevice();
+        model->StoreBufferToGPU(graphicsDevice.Get());
+        if (!model->GetIsBufferStoredOnGPU()) return;
+
+        if (renderer_->GetRenderMode() == ::Effekseer::RenderMode::Wireframe)
+        {
+            model->GenerateWireIndexBuffer(graphicsDevice.Get());
+            if (!model->GetIsWireIndexBufferGenerated()) return;
+        }
+
+        EndRendering_<SoftwareRenderer, SoftwareShader, ::Effekseer::Model, true, ModelInstanceCount>(
+            renderer_.Get(),
+            shaderAdvancedLit_,
+            shaderAdvancedUnlit_,
+            shaderAdvancedDistortion_,
+            shaderLit_,
+            shaderUnlit_,
+            shaderDistortion_,
+            parameter,
+            userData);
+    }
+}
@@ -0,0 +1,307 @@
+#pragma once
+
+// CPU rendering backend built on EffekseerRendererCommon.
+// It mirrors the structure of the DX11 backend (RendererImplemented, VertexBuffer, IndexBuffer,
+// RenderState, Shader, ModelRenderer) but keeps every buffer in plain memory and hands the
+// transformed triangles to SoftwareRasterizer, which writes a premultiplied BGRA8 frame.
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <Effekseer.h>
+#include "../../vendor/effekseer/src/EffekseerRendererCommon/EffekseerRenderer.IndexBufferBase.h"
+#include "../../vendor/effekseer/src/EffekseerRendererCommon/EffekseerRenderer.ModelRendererBase.h"
+#include "../../vendor/effekseer/src/EffekseerRendererCommon/EffekseerRenderer.RenderStateBase.h"
+#include "../../vendor/effekseer/src/EffekseerRendererCommon/EffekseerRenderer.Renderer.h"
+#include "../../vendor/effekseer/src/EffekseerRendererCommon/EffekseerRenderer.ShaderBase.h"
+#include "../../vendor/effekseer/src/EffekseerRendererCommon/EffekseerRenderer.StandardRenderer.h"
+#include "../../vendor/effekseer/src/EffekseerRendererCommon/EffekseerRenderer.VertexBufferBase.h"
+#include "SoftwareRasterizer.h"
+#include "VertexCapture.h"
+
+namespace EffekseerForNative
+{
+    // Texture decoded to RGBA8 (straight alpha) at creation. Only MIP level 0 is kept.
+    class SoftwareTexture : public ::Effekseer::Backend::Texture
+    {
+        std::vector<uint8_t> pixels_;
+
+    public:
+        bool Init(const ::Effekseer::Backend::TextureParameter& param, const ::Effekseer::CustomVector<uint8_t>& initialData);
+
+        RasterTexture GetRasterTexture() const;
+    };
+
+    class SoftwareBackendVertexBuffer : public ::Effekseer::Backend::VertexBuffer
+    {
+        std::vector<uint8_t> data_;
+
+    public:
+        SoftwareBackendVertexBuffer(int32_t size, const void* initialData);
+
+        void UpdateData(const void* src, int32_t size, int32_t offset) override;
+
+        const uint8_t* GetData() const { return data_.data(); }
+    };
+
+    class SoftwareBackendIndexBuffer : public ::Effekseer::Backend::IndexBuffer
+    {
+        std::vector<uint8_t> data_;
+
+    public:
+        SoftwareBackendIndexBuffer(int32_t elementCount, const void* initialData, ::Effekseer::Backend::IndexBufferStrideType stride);
+
+        void UpdateData(const void* src, int32_t size, int32_t offset) override;
+
+        const uint8_t* GetData() const { return data_.data(); }
+    };
+
+    class SoftwareGraphicsDevice : public ::Effekseer::Backend::GraphicsDevice
+    {
+    public:
+        ::Effekseer::Backend::VertexBufferRef CreateVertexBuffer(int32_t size, const void* initialData, bool isDynamic) override;
+        ::Effekseer::Backend::IndexBufferRef CreateIndexBuffer(int32_t elementCount, const void* initialData, ::Effekseer::Backend::IndexBufferStrideType stride) override;
+        bool UpdateVertexBuffer(::Effekseer::Backend::VertexBufferRef& buffer, int32_t size, int32_t offset, const void* data) override;
+        bool UpdateIndexBuffer(::Effekseer::Backend::IndexBufferRef& buffer, int32_t size, int32_t offset, const void* data) override;
+        ::Effekseer::Backend::TextureRef CreateTexture(const ::Effekseer::Backend::TextureParameter& param, const ::Effekseer::CustomVector<uint8_t>& initialData) override;
+        std::string GetDeviceName() const override { return "Software"; }
+    };
+
+    using SoftwareGraphicsDeviceRef = ::Effekseer::RefPtr<SoftwareGraphicsDevice>;
+
+    // Dynamic vertex buffer used as a ring buffer by StandardRenderer. Locks return pointers into the ring itself.
+    class SoftwareRingVertexBuffer : public ::EffekseerRenderer::VertexBufferBase
+    {
+        std::vector<uint8_t> storage_;
+        bool ringBufferLock_ = false;
+        bool ringBufferReserved_ = false;
+        int32_t reservedOffset_ = 0;
+
+    public:
+        SoftwareRingVertexBuffer(int32_t size);
+
+        void Lock() override;
+        bool RingBufferLock(int32_t size, int32_t& offset, void*& data, int32_t alignment) override;
+        bool TryRingBufferLock(int32_t size, int32_t& offset, void*& data, int32_t alignment) override;
+        bool ReserveRingBuffer(int32_t size, int32_t& offset, void*& data, int32_t alignment) override;
+        void CommitRingBuffer(int32_t size) override;
+        void Unlock() override;
+
+        const uint8_t* GetData() const { return storage_.data(); }
+    };
+
+    class SoftwareQuadIndexBuffer : public ::EffekseerRenderer::IndexBufferBase
+    {
+        std::vector<uint8_t> storage_;
+
+    public:
+        SoftwareQuadIndexBuffer(int32_t maxCount);
+
+        void Lock() override;
+        void Unlock() override;
+
+        const uint16_t* GetData() const { return reinterpret_cast<const uint16_t*>(storage_.data()); }
+    };
+
+    class SoftwareRenderState : public ::EffekseerRenderer::RenderStateBase
+    {
+    public:
+        void Update(bool forced) override;
+    };
+
+    enum class SoftwareVertexFormat
+    {
+        Simple,
+        Lighting,
+        AdvancedSimple,
+        AdvancedLighting,
+        Model,
+    };
+
+    // Stands in for a compiled shader pair: it only records which vertex layout and fixed-function path to use.
+    class SoftwareShader : public ::EffekseerRenderer::ShaderBase
+    {
+        SoftwareVertexFormat format_;
+        bool isLit_;
+        bool isAdvanced_;
+        bool isDistortion_;
+        std::vector<uint8_t> vertexConstantBuffer_;
+        std::vector<uint8_t> pixelConstantBuffer_;
+
+    public:
+        SoftwareShader(SoftwareVertexFormat format, bool isLit, bool isAdvanced, bool isDistortion);
+
+        void SetVertexConstantBufferSize(int32_t size) override;
+        void SetPixelConstantBufferSize(int32_t size) override;
+        void* GetVertexConstantBuffer() override { return vertexConstantBuffer_.data(); }
+        void* GetPixelConstantBuffer() override { return pixelConstantBuffer_.data(); }
+        int32_t GetVertexConstantBufferSize() const { return static_cast<int32_t>(vertexConstantBuffer_.size()); }
+        int32_t GetPixelConstantBufferSize() const { return static_cast<int32_t>(pixelConstantBuffer_.size()); }
+        void SetConstantBuffer() override {}
+
+        SoftwareVertexFormat GetFormat() const { return format_; }
+        bool GetIsLit() const { return isLit_; }
+        bool GetIsAdvanced() const { return isAdvanced_; }
+        bool GetIsDistortion() const { return isDistortion_; }
+    };
+
+    class SoftwareRenderer;
+    using SoftwareRendererRef = ::Effekseer::RefPtr<SoftwareRenderer>;
+
+    class SoftwareRenderer : public ::EffekseerRenderer::Renderer, public ::Effekseer::ReferenceObject, public ::Effekseer::SIMD::AlignedAllocationPolicy<16>
+    {
+    public:
+        // threadCount <= 0 uses every hardware thread. A 0x0 frame skips rasterization entirely,
+        // which together with EnableVertexCapture() gives a renderer that only records vertex generation.
+        static SoftwareRendererRef Create(int32_t width, int32_t height, int32_t squareMaxCount, int32_t threadCount = 0);
+
+        SoftwareRenderer(int32_t squareMaxCount);
+        ~SoftwareRenderer() override;
+
+        bool Initialize(int32_t width, int32_t height, int32_t threadCount);
+
+        void OnLostDevice() override {}
+        void OnResetDevice() override {}
+        void SetRestorationOfStatesFlag(bool /*flag*/) override {}
+
+        // Clears the frame; everything drawn until EndRendering() is rasterized when EndRendering() returns.
+        bool BeginRendering() override;
+        bool EndRendering() override;
+
+        int32_t GetSquareMaxCount() const override { return squareMaxCount_; }
+
+        ::EffekseerRenderer::StandardRendererStatistics GetStandardRendererStatistics() const override { return standardRenderer_->GetStatistics(); }
+        void ResetStandardRendererStatistics() override { standardRenderer_->ResetStatistics(); }
+        void SetDirectEmissionEnabled(bool enabled) override { standardRenderer_->SetDirectEmissionEnabled(enabled); }
+        bool GetDirectEmissionEnabled() const override { return standardRenderer_->GetDirectEmissionEnabled(); }
+
+        ::Effekseer::SpriteRendererRef CreateSpriteRenderer() override;
+        ::Effekseer::RibbonRendererRef CreateRibbonRenderer() override;
+        ::Effekseer::RingRendererRef CreateRingRenderer() override;
+        ::Effekseer::ModelRendererRef CreateModelRenderer() override;
+        ::Effekseer::TrackRendererRef CreateTrackRenderer() override;
+        ::Effekseer::TextureLoaderRef CreateTextureLoader(::Effekseer::FileInterfaceRef fileInterface = nullptr) override;
+        ::Effekseer::ModelLoaderRef CreateModelLoader(::Effekseer::FileInterfaceRef fileInterface = nullptr) override;
+        // Material shaders cannot run on the CPU; effects that use them skip those nodes.
+        ::Effekseer::MaterialLoaderRef CreateMaterialLoader(::Effekseer::FileInterfaceRef /*fileInterface*/ = nullptr) override { return nullptr; }
+
+        void ResetRenderState() override;
+        ::EffekseerRenderer::DistortingCallback* GetDistortingCallback() override { return nullptr; }
+        void SetDistortingCallback(::EffekseerRenderer::DistortingCallback* callback) override;
+        ::Effekseer::Backend::GraphicsDeviceRef GetGraphicsDevice() const override;
+
+        const uint8_t* GetFrameBuffer() const { return rasterizer_.GetColorBuffer(); }
+        int32_t GetFrameWidth() const { return rasterizer_.GetWidth(); }
+        int32_t GetFrameHeight() const { return rasterizer_.GetHeight(); }
+        int32_t GetFrameStride() const { return rasterizer_.GetStride(); }
+        int32_t GetThreadCount() const { return rasterizer_.GetThreadCount(); }
+
+        // Records every draw call's streams from the next BeginRendering() on.
+        // While enabled, batches are flushed whenever the renderer type changes so each draw call belongs to one type.
+        void EnableVertexCapture();
+        VertexCapture* GetVertexCapture() const { return capture_.get(); }
+
+        // Called by the node renderers around their work to attribute generation time and draw calls.
+        void BeginCaptureScope(VertexCaptureRendererType type);
+        void EndCaptureScope();
+
+        // Interface used by StandardRenderer and the renderer base templates.
+        SoftwareRingVertexBuffer* GetVertexBuffer() { return vertexBuffer_; }
+        SoftwareQuadIndexBuffer* GetIndexBuffer();
+        ::EffekseerRenderer::RenderStateBase* GetRenderState() { return renderState_; }
+        ::EffekseerRenderer::StandardRenderer<SoftwareRenderer, SoftwareShader>* GetStandardRenderer() { return standardRenderer_; }
+
+        void SetVertexBuffer(SoftwareRingVertexBuffer* vertexBuffer, int32_t stride);
+        void SetVertexBuffer(const ::Effekseer::Backend::VertexBufferRef& vertexBuffer, int32_t stride);
+        void SetIndexBuffer(SoftwareQuadIndexBuffer* indexBuffer);
+        void SetIndexBuffer(const ::Effekseer::Backend::IndexBufferRef& indexBuffer);
+        void SetLayout(SoftwareShader* /*shader*/) {}
+
+        void DrawSprites(int32_t spriteCount, int32_t vertexOffset);
+        void DrawPolygon(int32_t vertexCount, int32_t indexCount);
+        void DrawPolygonInstanced(int32_t vertexCount, int32_t indexCount, int32_t instanceCount);
+
+        SoftwareShader* GetShader(::EffekseerRenderer::RendererShaderType type) const;
+        void BeginShader(SoftwareShader* shader);
+        void EndShader(SoftwareShader* shader);
+        void SetVertexBufferToShader(const void* data, int32_t size, int32_t dstOffset);
+        void SetPixelBufferToShader(const void* data, int32_t size, int32_t dstOffset);
+        void SetTextures(SoftwareShader* shader, ::Effekseer::Backend::TextureRef* textures, int32_t count);
+
+        virtual int GetRef() override { return ::Effekseer::ReferenceObject::GetRef(); }
+        virtual int AddRef() override { return ::Effekseer::ReferenceObject::AddRef(); }
+        virtual int Release() override { return ::Effekseer::ReferenceObject::Release(); }
+
+    private:
+        int32_t AddDrawState();
+        void TransformVertices(int32_t vertexCount, int32_t instanceIndex);
+        void SubmitTriangles(int32_t stateIndex, int32_t indexCount, int32_t vertexBase);
+        void CaptureDraw(const uint8_t* vertices, int32_t vertexCount, int32_t indexCount, int32_t instanceCount);
+
+        int32_t squareMaxCount_;
+        SoftwareGraphicsDeviceRef graphicsDevice_;
+        SoftwareRingVertexBuffer* vertexBuffer_ = nullptr;
+        SoftwareQuadIndexBuffer* indexBuffer_ = nullptr;
+        SoftwareQuadIndexBuffer* indexBufferForWireframe_ = nullptr;
+        SoftwareRenderState* renderState_ = nullptr;
+
+        SoftwareShader* shaderUnlit_ = nullptr;
+        SoftwareShader* shaderLit_ = nullptr;
+        SoftwareShader* shaderDistortion_ = nullptr;
+        SoftwareShader* shaderAdUnlit_ = nullptr;
+        SoftwareShader* shaderAdLit_ = nullptr;
+        SoftwareShader* shaderAdDistortion_ = nullptr;
+        SoftwareShader* currentShader_ = nullptr;
+
+        ::EffekseerRenderer::StandardRenderer<SoftwareRenderer, SoftwareShader>* standardRenderer_ = nullptr;
+
+        // Bound input assembler state.
+        const uint8_t* boundVertices_ = nullptr;
+        bool boundVerticesStatic_ = false;
+        int32_t boundStride_ = 0;
+        const uint8_t* boundIndices_ = nullptr;
+        int32_t boundIndexStride_ = 2;
+        std::array<::Effekseer::Backend::TextureRef, ::Effekseer::TextureSlotMax> boundTextures_;
+        int32_t boundTextureCount_ = 0;
+
+        // Textures referenced by this frame's draw states, kept alive until the rasterizer has flushed.
+        std::vector<::Effekseer::Backend::TextureRef> frameTextures_;
+        std::vector<RasterVertex> transformed_;
+
+        bool rasterizationEnabled_ = false;
+        SoftwareRasterizer rasterizer_;
+
+        std::unique_ptr<VertexCapture> capture_;
+        VertexCaptureRendererType captureType_ = VertexCaptureRendererType::Sprite;
+        std::chrono::steady_clock::time_point captureScopeStart_;
+        ::EffekseerRenderer::StandardRendererStatistics frameUploadBegin_;
+    };
+
+    class SoftwareModelRenderer;
+    using SoftwareModelRendererRef = ::Effekseer::RefPtr<SoftwareModelRenderer>;
+
+    class SoftwareModelRenderer : public ::EffekseerRenderer::ModelRendererBase
+    {
+        SoftwareRendererRef renderer_;
+        SoftwareShader* shaderAdvancedLit_;
+        SoftwareShader* shaderAdvancedUnlit_;
+        SoftwareShader* shaderAdvancedDistortion_;
+        SoftwareShader* shaderLit_;
+        SoftwareShader* shaderUnlit_;
+        SoftwareShader* shaderDistortion_;
+
+        SoftwareModelRenderer(const SoftwareRendererRef& renderer);
+
+    public:
+        ~SoftwareModelRenderer() override;
+
+        static SoftwareModelRendererRef Create(const SoftwareRendererRef& renderer);
+
+        void BeginRendering(const NodeParameter& parameter, int32_t count, void* userData) override;
+        void Rendering(const NodeParameter& parameter, const InstanceParameter& instanceParameter, void* userData) override;
+        void EndRendering(const NodeParameter& parameter, void* userData) override;
+    };
+}
@@ -0,0 +1,166 @@
+#include "VertexCapture.h"
+
+#include <cstdio>
+
+namespace
+{
+    int32_t Append(std::vector<uint8_t>& stream, const void* data, size_t size)
+    {
+        auto offset = stream.size();
+        auto bytes = static_cast<const uint8_t*>(data);
+        stream.insert(stream.end(), bytes, bytes + size);
+        return static_cast<int32_t>(offset);
+    }
+}
+
+namespace EffekseerForNative
+{
+    void VertexCapture::BeginFrame()
+    {
+        vertices_.clear();
+        indices_.clear();
+        uniforms_.clear();
+        drawCalls_.clear();
+    }
+
+    void VertexCapture::EndFrame()
+    {
+        frameCount_++;
+    }
+
+    void VertexCapture::ResetStatistics()
+    {
+        statistics_ = {};
+        upload_ = {};
+        frameCount_ = 0;
+    }
+
+    void VertexCapture::RecordDraw(VertexCaptureRendererType type, const VertexCaptureDrawInput& input)
+    {
+        CapturedDrawCall drawCall;
+        drawCall.RendererType = type;
+        drawCall.VertexCount = input.VertexCount;
+        drawCall.Stride = input.Stride;
+        drawCall.IndexCount = input.IndexCount;
+        drawCall.IndexStride = input.IndexStride;
+        drawCall.VertexUniformSize = input.VertexUniformSize;
+        drawCall.PixelUniformSize = input.PixelUniformSize;
+        drawCall.InstanceCount = input.InstanceCount;
+
+        auto& statistics = statistics_[static_cast<int32_t>(type)];
+        statistics.DrawCalls++;
+        statistics.Vertices += static_cast<int64_t>(input.VertexCount) * input.InstanceCount;
+
+        if (input.Vertices != nullptr)
+        {
+            const auto size = static_cast<size_t>(input.VertexCount) * input.Stride;
+            drawCall.VertexOffset = Append(vertices_, input.Vertices, size);
+            statistics.VertexBytes += size;
+        }
+
+        if (input.Indices != nullptr)
+        {
+            const auto size = static_cast<size_t>(input.IndexCount) * input.IndexStride;
+            drawCall.IndexOffset = Append(indices_, input.Indices, size);
+            statistics.IndexBytes += size;
+        }
+
+        drawCall.UniformOffset = static_cast<int32_t>(uniforms_.size());
+        if (input.VertexUniforms != nullptr)
+        {
+            Append(uniforms_, input.VertexUniforms, input.VertexUniformSize);
+            statistics.UniformBytes += input.VertexUniformSize;
+        }
+        if (input.PixelUniforms != nullptr)
+        {
+            Append(uniforms_, input.PixelUniforms, input.PixelUniformSize);
+            statistics.UniformBytes += input.PixelUniformSize;
+        }
+
+        drawCalls_.push_back(drawCall);
+    }
+
+    void VertexCapture::AddGenerationTime(VertexCaptureRendererType type, int64_t nanoseconds)
+    {
+        statistics_[static_cast<int32_t>(type)].GenerationNanoseconds += nanoseconds;
+    }
+
+    void VertexCapture::AddUpload(int64_t directBytes, int64_t stagedBytes, int64_t copiedBytes)
+    {
+        upload_.DirectBytes += directBytes;
+        upload_.StagedBytes += stagedBytes;
+        upload_.CopiedBytes += copiedBytes;
+    }
+
+    double VertexCapture::GetVerticesPerSecond(VertexCaptureRendererType type) const
+    {
+        const auto& statistics = GetStatistics(type);
+        if (statistics.GenerationNanoseconds <= 0) return 0.0;
+        return statistics.Vertices * 1.0e9 / statistics.GenerationNanoseconds;
+    }
+
+    double VertexCapture::GetBytesPerFrame(VertexCaptureRendererType type) const
+    {
+        if (frameCount_ == 0) return 0.0;
+        const auto& statistics = GetStatistics(type);
+        return static_cast<double>(statistics.VertexBytes + statistics.IndexBytes + statistics.UniformBytes) / frameCount_;
+    }
+
+    double VertexCapture::GetDrawCallsPerFrame(VertexCaptureRendererType type) const
+    {
+        if (frameCount_ == 0) return 0.0;
+        return static_cast<double>(GetStatistics(type).DrawCalls) / frameCount_;
+    }
+
+    std::string VertexCapture::FormatReport() const
+    {
+        std::string report;
+        char line[256];
+        for (int32_t i = 0; i < VertexCaptureRendererTypeCount; i++)
+        {
+            const auto type = static_cast<VertexCaptureRendererType>(i);
+            const auto& statistics = GetStatistics(type);
+            if (statistics.DrawCalls == 0) continue;
+
+            snprintf(line, sizeof(line), "%s: %.0f vertices/s, %.0f bytes/frame (vertex %lld, index %lld, uniform %lld), %.2f draw calls/frame\n",
+                GetRendererTypeName(type),
+                GetVerticesPerSecond(type),
+                GetBytesPerFrame(type),
+                static_cast<long long>(frameCount_ > 0 ? statistics.VertexBytes / frameCount_ : 0),
+                static_cast<long long>(frameCount_ > 0 ? statistics.IndexBytes / frameCount_ : 0),
+                static_cast<long long>(frameCount_ > 0 ? statistics.UniformBytes / frameCount_ : 0),
+                GetDrawCallsPerFrame(type));
+            report += line;
+        }
+
+        if (frameCount_ > 0 && upload_.DirectBytes + upload_.StagedBytes > 0)
+        {
+            snprintf(line, sizeof(line), "Upload: %lld bytes/frame (direct %lld, staged %lld, copied %lld)\n",
+                static_cast<long long>((upload_.DirectBytes + upload_.StagedBytes + upload_.CopiedBytes) / frameCount_),
+                static_cast<long long>(upload_.DirectBytes / frameCount_),
+                static_cast<long long>(upload_.StagedBytes / frameCount_),
+                static_cast<long long>(upload_.CopiedBytes / frameCount_));
+            report += line;
+        }
+        return report;
+    }
+
+    const char* VertexCapture::GetRendererTypeName(VertexCaptureRendererType type)
+    {
+        switch (type)
+        {
+        case VertexCaptureRendererType::Sprite:
+            return "Sprite";
+        case VertexCaptureRendererType::Ribbon:
+            return "Ribbon";
+        case VertexCaptureRendererType::Ring:
+            return "Ring";
+        case VertexCaptureRendererType::Track:
+            return "Track";
+        case VertexCaptureRendererType::Model:
+            return "Model";
+        default:
+            return "Unknown";
+        }
+    }
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+// Records what the renderer base classes hand to the backend: the vertex, index and
+// constant-buffer streams and the draw-call list, together with the CPU time spent
+// generating them, split by renderer type.
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace EffekseerForNative
+{
+    enum class VertexCaptureRendererType : int32_t
+    {
+        Sprite,
+        Ribbon,
+        Ring,
+        Track,
+        Model,
+    };
+
+    constexpr int32_t VertexCaptureRendererTypeCount = 5;
+
+    // Raw views of what a single draw call reads. Vertices and Indices are null when the
+    // draw reads a static buffer (model geometry), so only per-frame data is copied.
+    struct VertexCaptureDrawInput
+    {
+        const void* Vertices = nullptr;
+        int32_t VertexCount = 0;
+        int32_t Stride = 0;
+        const void* Indices = nullptr;
+        int32_t IndexCount = 0;
+        int32_t IndexStride = 2;
+        const void* VertexUniforms = nullptr;
+        int32_t VertexUniformSize = 0;
+        const void* PixelUniforms = nullptr;
+        int32_t PixelUniformSize = 0;
+        int32_t InstanceCount = 1;
+    };
+
+    // Offsets are byte offsets into the corresponding captured stream, or -1 when nothing was copied.
+    struct CapturedDrawCall
+    {
+        VertexCaptureRendererType RendererType = VertexCaptureRendererType::Sprite;
+        int32_t VertexOffset = -1;
+        int32_t VertexCount = 0;
+        int32_t Stride = 0;
+        int32_t IndexOffset = -1;
+        int32_t IndexCount = 0;
+        int32_t IndexStride = 2;
+        int32_t UniformOffset = -1;
+        int32_t VertexUniformSize = 0;
+        int32_t PixelUniformSize = 0;
+        int32_t InstanceCount = 1;
+    };
+
+    struct VertexCaptureStatistics
+    {
+        int64_t GenerationNanoseconds = 0;
+        int64_t Vertices = 0;
+        int64_t VertexBytes = 0;
+        int64_t IndexBytes = 0;
+        int64_t UniformBytes = 0;
+        int64_t DrawCalls = 0;
+    };
+
+    // How the generated vertices reached the vertex buffer: written into it directly, or staged and copied.
+    struct VertexUploadStatistics
+    {
+        int64_t DirectBytes = 0;
+        int64_t StagedBytes = 0;
+        int64_t CopiedBytes = 0;
+    };
+
+    class VertexCapture
+    {
+    public:
+        // Clears the streams of the previous frame; statistics keep accumulating until ResetStatistics().
+        void BeginFrame();
+        void EndFrame();
+        void ResetStatistics();
+
+        void RecordDraw(VertexCaptureRendererType type, const VertexCaptureDrawInput& input);
+        void AddGenerationTime(VertexCaptureRendererType type, int64_t nanoseconds);
+        void AddUpload(int64_t directBytes, int64_t stagedBytes, int64_t copiedBytes);
+
+        const std::vector<uint8_t>& GetVertexStream() const { return vertices_; }
+        const std::vector<uint8_t>& GetIndexStream() const { return indices_; }
+        const std::vector<uint8_t>& GetUniformStream() const { return uniforms_; }
+        const std::vector<CapturedDrawCall>& GetDrawCalls() const { return drawCalls_; }
+
+        const VertexCaptureStatistics& GetStatistics(VertexCaptureRendererType type) const { return statistics_[static_cast<int32_t>(type)]; }
+        const VertexUploadStatistics& GetUploadStatistics() const { return upload_; }
+        int32_t GetFrameCount() const { return frameCount_; }
+
+        double GetVerticesPerSecond(VertexCaptureRendererType type) const;
+        double GetBytesPerFrame(VertexCaptureRendererType type) const;
+        double GetDrawCallsPerFrame(VertexCaptureRendererType type) const;
+
+        // One line per renderer type that produced any draw call, followed by the vertex upload line.
+        std::string FormatReport() const;
+
+        static const char* GetRendererTypeName(VertexCaptureRendererType type);
+
+    private:
+        std::vector<uint8_t> vertices_;
+        std::vector<uint8_t> indices_;
+        std::vector<uint8_t> uniforms_;
+        std::vector<CapturedDrawCall> drawCalls_;
+
+        std::array<VertexCaptureStatistics, VertexCaptureRendererTypeCount> statistics_;
+        VertexUploadStatistics upload_;
+        int32_t frameCount_ = 0;
+    };
+}
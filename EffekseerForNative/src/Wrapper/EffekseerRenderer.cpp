@@ -51,6 +51,36 @@ namespace EffekseerForNative {
         return true;
     }
 
+    bool EffekseerRenderer::InitializeSoftware(int width, int height, int threadCount)
+    {
+        if (!m_impl) return false;
+
+        if (!m_impl->InitializeSoftware(width, height, threadCount))
+        {
+            return false;
+        }
+
+        m_impl->SetProjection(width, height);
+        m_impl->SetCamera(20.0f);
+
+        return true;
+    }
+
+    bool EffekseerRenderer::InitializeCapture(int width, int height)
+    {
+        if (!m_impl) return false;
+
+        if (!m_impl->InitializeCapture())
+        {
+            return false;
+        }
+
+        m_impl->SetProjection(width, height);
+        m_impl->SetCamera(20.0f);
+
+        return true;
+    }
+
     bool EffekseerRenderer::LoadEffect(System::String^ path)
     {
         if (!m_impl) return false;
@@ -68,6 +98,22 @@ namespace EffekseerForNative {
         return true;
     }
 
+    void EffekseerRenderer::EnableHotReload(bool enabled, int debounceMilliseconds)
+    {
+        if (m_impl)
+        {
+            m_impl->EnableHotReload(enabled, debounceMilliseconds);
+        }
+    }
+
+    System::String^ EffekseerRenderer::HotReloadReport::get()
+    {
+        if (!m_impl) return nullptr;
+
+        auto report = m_impl->GetHotReloadReport();
+        return gcnew System::String(report.c_str());
+    }
+
     System::String^ EffekseerRenderer::LastErrorMessage::get()
     {
         if (!m_impl)
@@ -92,6 +138,137 @@ namespace EffekseerForNative {
         }
     }
 
+    bool EffekseerRenderer::CopySoftwareFrame(IntPtr destination, int stride, int height)
+    {
+        if (!m_impl || destination == IntPtr::Zero) return false;
+
+        return m_impl->CopySoftwareFrame((uint8_t*)destination.ToPointer(), stride, height);
+    }
+
+    int EffekseerRenderer::SoftwareFrameWidth::get()
+    {
+        return m_impl ? m_impl->GetSoftwareFrameWidth() : 0;
+    }
+
+    int EffekseerRenderer::SoftwareFrameHeight::get()
+    {
+        return m_impl ? m_impl->GetSoftwareFrameHeight() : 0;
+    }
+
+    System::String^ EffekseerRenderer::CaptureReport::get()
+    {
+        if (!m_impl) return nullptr;
+
+        auto report = m_impl->GetCaptureReport();
+        return gcnew System::String(report.c_str());
+    }
+
+    void EffekseerRenderer::ResetCaptureStatistics()
+    {
+        if (m_impl)
+        {
+            m_impl->ResetCaptureStatistics();
+        }
+    }
+
+    array<Byte>^ EffekseerRenderer::GetCapturedVertices()
+    {
+        auto stream = m_impl ? m_impl->GetCapturedVertexStream() : nullptr;
+        if (stream == nullptr) return nullptr;
+
+        auto vertices = gcnew array<Byte>(static_cast<int>(stream->size()));
+        if (!stream->empty())
+        {
+            pin_ptr<Byte> destination = &vertices[0];
+            memcpy(destination, stream->data(), stream->size());
+        }
+        return vertices;
+    }
+
+    bool EffekseerRenderer::DirectEmissionEnabled::get()
+    {
+        return m_impl ? m_impl->GetDirectEmissionEnabled() : false;
+    }
+
+    void EffekseerRenderer::DirectEmissionEnabled::set(bool value)
+    {
+        if (m_impl)
+        {
+            m_impl->SetDirectEmissionEnabled(value);
+        }
+    }
+
+    int EffekseerRenderer::MinCachedSplineSegmentCount::get()
+    {
+        return m_impl ? m_impl->GetMinCachedSplineSegmentCount() : -1;
+    }
+
+    void EffekseerRenderer::MinCachedSplineSegmentCount::set(int value)
+    {
+        if (m_impl)
+        {
+            m_impl->SetMinCachedSplineSegmentCount(value);
+        }
+    }
+
+    System::String^ EffekseerRenderer::UploadReport::get()
+    {
+        if (!m_impl) return nullptr;
+
+        auto report = m_impl->GetUploadReport();
+        return gcnew System::String(report.c_str());
+    }
+
+    void EffekseerRenderer::ResetUploadStatistics()
+    {
+        if (m_impl)
+        {
+            m_impl->ResetUploadStatistics();
+        }
+    }
+
+    void EffekseerRenderer::EnableNodeStatistics(bool enabled)
+    {
+        if (m_impl)
+        {
+            m_impl->EnableNodeStatistics(enabled);
+        }
+    }
+
+    System::String^ EffekseerRenderer::NodeStatisticsReport::get()
+    {
+        if (!m_impl) return nullptr;
+
+        auto report = m_impl->GetNodeStatisticsReport();
+        return gcnew System::String(report.c_str());
+    }
+
+    void EffekseerRenderer::ResetNodeStatistics()
+    {
+        if (m_impl)
+        {
+            m_impl->ResetNodeStatistics();
+        }
+    }
+
+    int EffekseerRenderer::InstanceLimit::get()
+    {
+        return m_impl ? m_impl->GetInstanceLimit() : 0;
+    }
+
+    void EffekseerRenderer::InstanceLimit::set(int value)
+    {
+        if (m_impl)
+        {
+            m_impl->SetInstanceLimit(value);
+        }
+    }
+
+    Int64 EffekseerRenderer::AllocatedInstanceBytes::get()
+    {
+        return m_impl ? static_cast<Int64>(m_impl->GetAllocatedInstanceBytes()) : 0;
+    }
+
     void EffekseerRenderer::Update(float deltaFrames)
     {
         if (m_impl)
@@ -16,9 +16,30 @@ namespace EffekseerForNative {
             !EffekseerRenderer();
 
             bool Initialize(IntPtr device, IntPtr context, int width, int height);
+            bool InitializeSoftware(int width, int height, int threadCount);
+            bool InitializeCapture(int width, int height);
             bool LoadEffect(System::String^ path);
+            void EnableHotReload(bool enabled, int debounceMilliseconds);
+            property System::String^ HotReloadReport { System::String^ get(); }
             property System::String^ LastErrorMessage { System::String^ get(); }
             void Render();
+            bool CopySoftwareFrame(IntPtr destination, int stride, int height);
+            property int SoftwareFrameWidth { int get(); }
+            property int SoftwareFrameHeight { int get(); }
+            property System::String^ CaptureReport { System::String^ get(); }
+            void ResetCaptureStatistics();
+            // The vertex stream of the last Render() in capture mode, or null outside it.
+            array<Byte>^ GetCapturedVertices();
+            property bool DirectEmissionEnabled { bool get(); void set(bool value); }
+            property int MinCachedSplineSegmentCount { int get(); void set(int value); }
+            property System::String^ UploadReport { System::String^ get(); }
+            void ResetUploadStatistics();
+            void EnableNodeStatistics(bool enabled);
+            property System::String^ NodeStatisticsReport { System::String^ get(); }
+            void ResetNodeStatistics();
+            // Set before Initialize. 0 means no limit.
+            property int InstanceLimit { int get(); void set(int value); }
+            property Int64 AllocatedInstanceBytes { Int64 get(); }
             void Update(float deltaFrames);
             void SetSoundCallback(System::IntPtr loadSound, System::IntPtr unloadSound, System::IntPtr playSound);
             void SetProjection(int width, int height);
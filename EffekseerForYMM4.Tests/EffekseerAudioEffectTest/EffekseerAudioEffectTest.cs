@@ -121,6 +121,91 @@ namespace EffekseerForYMM4.Tests
             SaveWav(outputPath, allSamples.ToArray(), sampleRate, 2);
         }
 
+        // 1024サンプルずつ読むとブロックは1フレームより短く、エフェクトを再生し直すのは100フレームごとのループの折り返しだけになる。
+        // 30秒を4区間に均等に分けた位置はどれも折り返しの間にあるので、境界は近くの折り返しに移される。
+        // 8820サンプル（0.1秒）ずつ読むと、逐次処理でも毎ブロック再生し直す
+        [Theory]
+        [InlineData(1024)]
+        [InlineData(8820)]
+        public void TestParallelExportMatchesSequential(int bufferSize)
+        {
+            var effect = CreateLaserEffect();
+
+            var duration = TimeSpan.FromSeconds(30);
+            var sequential = Render(effect, duration, bufferSize, 1);
+            var parallel = Render(effect, duration, bufferSize, 4);
+
+            Assert.Equal(0, sequential.SegmentCount);
+            Assert.True(parallel.SegmentCount > 1, $"{parallel.SegmentCount} segments");
+            Assert.True(parallel.ParallelBlockCount > 0);
+
+            Assert.Equal(sequential.Samples.Length, parallel.Samples.Length);
+            for (int i = 0; i < sequential.Samples.Length; i++)
+            {
+                Assert.True(sequential.Samples[i] == parallel.Samples[i], $"Sample {i} differs: {sequential.Samples[i]} != {parallel.Samples[i]}");
+            }
+            Assert.Contains(sequential.Samples, s => s != 0);
+        }
+
+        [Fact]
+        public void TestParallelExportSpeed()
+        {
+            Assert.SkipWhen(Environment.ProcessorCount < 2, "Parallel export needs at least two cores.");
+
+            var effect = CreateLaserEffect();
+            var duration = TimeSpan.FromSeconds(30);
+
+            // JIT とファイルキャッシュの分を除く
+            Render(effect, TimeSpan.FromSeconds(2), 8820, 1);
+
+            var watch = System.Diagnostics.Stopwatch.StartNew();
+            var sequential = Render(effect, duration, 8820, 1);
+            var sequentialTime = watch.Elapsed;
+
+            watch.Restart();
+            var parallel = Render(effect, duration, 8820, Environment.ProcessorCount);
+            var parallelTime = watch.Elapsed;
+
+            Assert.Equal(sequential.Samples.Length, parallel.Samples.Length);
+            Assert.Contains(parallel.Samples, s => s != 0);
+
+            TestContext.Current.SendDiagnosticMessage($"parallel export: sequential {sequentialTime.TotalMilliseconds:F0}ms, parallel {parallelTime.TotalMilliseconds:F0}ms ({sequentialTime / parallelTime:F2}x) in {parallel.SegmentCount} segments on {Environment.ProcessorCount} cores");
+        }
+
+        private static EffekseerForYMM4.EffekseerAudioEffect.EffekseerAudioEffect CreateLaserEffect()
+        {
+            var effect = new EffekseerForYMM4.EffekseerAudioEffect.EffekseerAudioEffect();
+            var resourcesPath = Path.Combine(AppDomain.CurrentDomain.BaseDirectory, "Resources", "Laser01.efkefc");
+
+            Assert.True(File.Exists(resourcesPath), $"Effect file not found: {resourcesPath}");
+
+            effect.FilePath = resourcesPath;
+            effect.Volume.Values[0].Value = 100;
+            return effect;
+        }
+
+        private static (float[] Samples, int SegmentCount, int ParallelBlockCount) Render(EffekseerForYMM4.EffekseerAudioEffect.EffekseerAudioEffect effect, TimeSpan duration, int bufferSize, int segmentCount)
+        {
+            using var silentSource = new SilentSource(44100, duration);
+            using var processor = (EffekseerAudioEffectProcessor)effect.CreateAudioEffect(duration);
+            processor.Input = silentSource;
+            processor.SegmentCount = segmentCount;
+
+            long totalSamplesToRead = silentSource.Duration * 2; // Stereo
+            var output = new float[totalSamplesToRead];
+            long readTotal = 0;
+
+            while (readTotal < totalSamplesToRead)
+            {
+                int count = (int)Math.Min(bufferSize, totalSamplesToRead - readTotal);
+                int readCount = processor.Read(output, (int)readTotal, count);
+
+                if (readCount == 0) break;
+                readTotal += readCount;
+            }
+            return (output, processor.ParallelSegmentCount, processor.ParallelBlockCount);
+        }
+
         private void SaveWav(string filename, float[] floatBuffer, int sampleRate, int channels)
         {
             using (var stream = new FileStream(filename, FileMode.Create))
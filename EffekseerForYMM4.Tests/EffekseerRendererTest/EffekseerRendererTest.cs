@@ -0,0 +1,391 @@
+using System;
+using System.Diagnostics;
+using System.Globalization;
+using System.IO;
+using System.Runtime.InteropServices;
+using System.Text.RegularExpressions;
+using Xunit;
+
+namespace EffekseerForYMM4.Tests
+{
+    public class EffekseerRendererTest
+    {
+        private static string GetResourcePath(string name)
+        {
+            var path = Path.Combine(AppDomain.CurrentDomain.BaseDirectory, "Resources", name);
+            Assert.True(File.Exists(path), $"Effect file not found: {path}");
+            return path;
+        }
+
+        // Trail01 は Laser01 の2番目のノードをリボン、5番目のノードを軌跡に置き換えたもの
+        [Fact]
+        public void TestTrailCaptureBenchmark()
+        {
+            var path = GetResourcePath("Trail01.efkefc");
+
+            using var renderer = new EffekseerForNative.EffekseerRenderer();
+            Assert.True(renderer.InitializeCapture(1920, 1080));
+            Assert.True(renderer.LoadEffect(path), renderer.LastErrorMessage);
+
+            const int warmupFrames = 60;
+            const int frames = 1200;
+            var watch = new Stopwatch();
+            for (int frame = 0; frame < warmupFrames + frames; frame++)
+            {
+                if (frame == warmupFrames)
+                {
+                    renderer.ResetCaptureStatistics();
+                    watch.Start();
+                }
+                if (frame % 10 == 0)
+                {
+                    renderer.PlayEffect(path, frame % 40 - 20.0f, 0, 0);
+                }
+                renderer.Update(1.0f);
+                renderer.Render();
+            }
+            watch.Stop();
+
+            var report = renderer.CaptureReport;
+            Assert.Contains("Ribbon:", report);
+            Assert.Contains("Track:", report);
+
+            TestContext.Current.SendDiagnosticMessage($"trail capture: {watch.Elapsed.TotalMilliseconds * 1000 / frames:F1}us/frame\n{report}");
+
+            // スプラインのキャッシュを全ての軌跡で使った場合と使わない場合で頂点が一致することを確認する
+            using var cached = new EffekseerForNative.EffekseerRenderer();
+            using var uncached = new EffekseerForNative.EffekseerRenderer();
+            cached.MinCachedSplineSegmentCount = 0;
+            uncached.MinCachedSplineSegmentCount = int.MaxValue;
+            foreach (var target in new[] { cached, uncached })
+            {
+                Assert.True(target.InitializeCapture(1920, 1080));
+                Assert.True(target.LoadEffect(path), target.LastErrorMessage);
+            }
+            Assert.Equal(0, cached.MinCachedSplineSegmentCount);
+            Assert.Equal(int.MaxValue, uncached.MinCachedSplineSegmentCount);
+
+            int comparedFrames = 0;
+            for (int frame = 0; frame < 240; frame++)
+            {
+                var cachedVertices = RenderCapturedFrame(cached, path, frame);
+                var uncachedVertices = RenderCapturedFrame(uncached, path, frame);
+
+                Assert.NotNull(cachedVertices);
+                Assert.True(cachedVertices.AsSpan().SequenceEqual(uncachedVertices), $"frame {frame}: cached {cachedVertices.Length} bytes, uncached {uncachedVertices.Length} bytes");
+                if (cachedVertices.Length > 0) comparedFrames++;
+            }
+            Assert.True(comparedFrames > 0);
+        }
+
+        // Laser01 のノード 1 はパーティクルを最も多く出すスプライト
+        [Fact]
+        public void TestNodeStatistics()
+        {
+            var path = GetResourcePath("Laser01.efkefc");
+
+            using var renderer = new EffekseerForNative.EffekseerRenderer();
+            Assert.True(renderer.InitializeCapture(1920, 1080));
+            Assert.True(renderer.LoadEffect(path), renderer.LastErrorMessage);
+            renderer.EnableNodeStatistics(true);
+
+            for (int frame = 0; frame < 120; frame++)
+            {
+                if (frame % 30 == 0)
+                {
+                    renderer.PlayEffect(path, 0, 0, 0);
+                }
+                renderer.Update(1.0f);
+                renderer.Render();
+            }
+
+            var report = renderer.NodeStatisticsReport;
+            Assert.Contains("per frame over 120 frames", report);
+            var node = Regex.Match(report, @"^ +1 Sprite: ([\d.]+) instance updates, ([\d.]+) spawns, ([\d.]+) us update, (\d+) vertices, ([\d.]+) draw calls$", RegexOptions.Multiline);
+            Assert.True(node.Success, report);
+            for (int i = 1; i < node.Groups.Count; i++)
+            {
+                Assert.True(double.Parse(node.Groups[i].Value, CultureInfo.InvariantCulture) > 0, $"{node.Value}: value {i} is zero");
+            }
+
+            renderer.ResetNodeStatistics();
+            Assert.Empty(renderer.NodeStatisticsReport);
+
+            TestContext.Current.SendDiagnosticMessage(report);
+        }
+
+        // 同じフレームを頂点バッファへの直接書き込みとステージング経由で2回描画し、頂点が一致することを確認する
+        [Fact]
+        public void TestDirectEmissionMatchesStaged()
+        {
+            var path = GetResourcePath("Laser01.efkefc");
+
+            using var renderer = new EffekseerForNative.EffekseerRenderer();
+            Assert.True(renderer.InitializeCapture(1920, 1080));
+            Assert.True(renderer.DirectEmissionEnabled);
+            Assert.True(renderer.LoadEffect(path), renderer.LastErrorMessage);
+
+            int comparedFrames = 0;
+            for (int frame = 0; frame < 240; frame++)
+            {
+                if (frame % 4 == 0)
+                {
+                    renderer.PlayEffect(path, frame % 40 - 20.0f, 0, 0);
+                }
+                renderer.Update(1.0f);
+
+                renderer.DirectEmissionEnabled = true;
+                renderer.Render();
+                var direct = renderer.GetCapturedVertices();
+
+                renderer.DirectEmissionEnabled = false;
+                renderer.Render();
+                var staged = renderer.GetCapturedVertices();
+
+                Assert.NotNull(direct);
+                Assert.True(direct.AsSpan().SequenceEqual(staged), $"frame {frame}: direct {direct.Length} bytes, staged {staged.Length} bytes");
+                if (direct.Length > 0) comparedFrames++;
+            }
+            Assert.True(comparedFrames > 0);
+
+            var report = renderer.UploadReport;
+            Assert.Contains("Upload:", report);
+            Assert.DoesNotContain("(direct 0,", report);
+            TestContext.Current.SendDiagnosticMessage(report);
+        }
+
+        // ソフトウェア描画の結果が描画スレッド数や実行ごとに変わらないことを確認する
+        [Fact]
+        public void TestSoftwareRenderingIsDeterministic()
+        {
+            var path = GetResourcePath("Laser01.efkefc");
+
+            var single = RenderSoftwareFrames(path, 1);
+            var parallel = RenderSoftwareFrames(path, 4);
+            var again = RenderSoftwareFrames(path, 1);
+
+            int writtenFrames = 0;
+            for (int frame = 0; frame < single.Length; frame++)
+            {
+                if (Array.Exists(single[frame], value => value != 0)) writtenFrames++;
+                Assert.True(single[frame].AsSpan().SequenceEqual(parallel[frame]), $"frame {frame}: 1 thread and 4 threads differ");
+                Assert.True(single[frame].AsSpan().SequenceEqual(again[frame]), $"frame {frame}: two runs differ");
+            }
+            Assert.True(writtenFrames > 0);
+        }
+
+        private static byte[][] RenderSoftwareFrames(string path, int threadCount)
+        {
+            const int width = 320;
+            const int height = 180;
+            const int stride = width * 4;
+
+            using var renderer = new EffekseerForNative.EffekseerRenderer();
+            Assert.True(renderer.InitializeSoftware(width, height, threadCount));
+            Assert.Equal(width, renderer.SoftwareFrameWidth);
+            Assert.Equal(height, renderer.SoftwareFrameHeight);
+            Assert.True(renderer.LoadEffect(path), renderer.LastErrorMessage);
+            renderer.PlayEffect(path, 0, 0, 0);
+
+            var frames = new byte[60][];
+            var buffer = Marshal.AllocHGlobal(stride * height);
+            try
+            {
+                for (int frame = 0; frame < frames.Length; frame++)
+                {
+                    renderer.Update(1.0f);
+                    renderer.Render();
+                    Assert.True(renderer.CopySoftwareFrame(buffer, stride, height));
+                    frames[frame] = new byte[stride * height];
+                    Marshal.Copy(buffer, frames[frame], 0, frames[frame].Length);
+                }
+            }
+            finally
+            {
+                Marshal.FreeHGlobal(buffer);
+            }
+            return frames;
+        }
+
+        // 一時ディレクトリにコピーしたエフェクトを書き換え、再読み込みされることと壊れた本体では前の版が残ることを確認する
+        [Fact]
+        public void TestHotReload()
+        {
+            var directory = Path.Combine(Path.GetTempPath(), $"EffekseerHotReload{Guid.NewGuid():N}");
+            Directory.CreateDirectory(Path.Combine(directory, "Texture"));
+            try
+            {
+                var source = GetResourcePath("Laser01.efkefc");
+                var path = Path.Combine(directory, "Laser01.efkefc");
+                File.Copy(source, path);
+                foreach (var texture in Directory.GetFiles(Path.Combine(Path.GetDirectoryName(source)!, "Texture")))
+                {
+                    File.Copy(texture, Path.Combine(directory, "Texture", Path.GetFileName(texture)));
+                }
+
+                using var renderer = new EffekseerForNative.EffekseerRenderer();
+                Assert.True(renderer.InitializeCapture(1920, 1080));
+                renderer.EnableHotReload(true, 0);
+                Assert.True(renderer.LoadEffect(path), renderer.LastErrorMessage);
+                renderer.PlayEffect(path, 0, 0, 0);
+                for (int frame = 0; frame < 30; frame++)
+                {
+                    renderer.Update(1.0f);
+                }
+
+                // 末尾に1バイト足しても読み込める
+                var body = File.ReadAllBytes(path);
+                var edited = new byte[body.Length + 1];
+                body.CopyTo(edited, 0);
+                File.WriteAllBytes(path, edited);
+                var record = PollHotReload(renderer, 1);
+                Assert.NotNull(record);
+                Assert.Contains("effect and", record);
+
+                // 同じ内容で上書きしただけでは再読み込みしない
+                File.WriteAllBytes(path, edited);
+                Assert.Null(PollHotReload(renderer, 2));
+
+                File.WriteAllText(path, "exporter is still writing");
+                record = PollHotReload(renderer, 2);
+                Assert.NotNull(record);
+                Assert.Contains("previous version is kept", record);
+
+                renderer.Update(1.0f);
+                renderer.Render();
+                Assert.NotEmpty(renderer.GetCapturedVertices());
+
+                // 読み込み済みの内容に戻しても再読み込みしない
+                File.WriteAllBytes(path, edited);
+                Assert.Null(PollHotReload(renderer, 3));
+
+                TestContext.Current.SendDiagnosticMessage(renderer.HotReloadReport);
+            }
+            finally
+            {
+                Directory.Delete(directory, true);
+            }
+        }
+
+        // 音声エフェクトと同じヘッドレスのレンダラーをアイテムの数だけ作ったときのインスタンス領域
+        [Fact]
+        public void TestHeadlessInstanceMemory()
+        {
+            var path = GetResourcePath("Laser01.efkefc");
+
+            const int rendererCount = 32;
+            var renderers = new EffekseerForNative.EffekseerRenderer[rendererCount];
+            try
+            {
+                for (int i = 0; i < rendererCount; i++)
+                {
+                    renderers[i] = new EffekseerForNative.EffekseerRenderer();
+                    Assert.True(renderers[i].Initialize(IntPtr.Zero, IntPtr.Zero, 800, 600));
+                }
+                long empty = SumAllocatedInstanceBytes(renderers);
+
+                foreach (var renderer in renderers)
+                {
+                    Assert.True(renderer.LoadEffect(path), renderer.LastErrorMessage);
+                }
+                long peak = 0;
+                for (int frame = 0; frame < 120; frame++)
+                {
+                    foreach (var renderer in renderers)
+                    {
+                        renderer.Update(1.0f);
+                    }
+                    peak = Math.Max(peak, SumAllocatedInstanceBytes(renderers));
+                }
+
+                foreach (var renderer in renderers)
+                {
+                    renderer.StopRoot();
+                }
+                for (int frame = 0; frame < 200; frame++)
+                {
+                    foreach (var renderer in renderers)
+                    {
+                        renderer.Update(1.0f);
+                    }
+                }
+                long idle = SumAllocatedInstanceBytes(renderers);
+
+                Assert.True(peak > empty);
+                Assert.True(idle < peak, $"idle {idle} bytes, peak {peak} bytes");
+
+                TestContext.Current.SendDiagnosticMessage($"instance memory per renderer: empty {empty / rendererCount / 1024.0:F1}KB, playing Laser01 {peak / rendererCount / 1024.0:F1}KB, after 200 idle updates {idle / rendererCount / 1024.0:F1}KB");
+            }
+            finally
+            {
+                foreach (var renderer in renderers)
+                {
+                    renderer?.Dispose();
+                }
+            }
+        }
+
+        [Fact]
+        public void TestInstanceLimit()
+        {
+            var path = GetResourcePath("Laser01.efkefc");
+
+            using var unlimited = new EffekseerForNative.EffekseerRenderer();
+            using var limited = new EffekseerForNative.EffekseerRenderer();
+            limited.InstanceLimit = 32;
+            Assert.True(unlimited.Initialize(IntPtr.Zero, IntPtr.Zero, 800, 600));
+            Assert.True(limited.Initialize(IntPtr.Zero, IntPtr.Zero, 800, 600));
+            Assert.Equal(32, limited.InstanceLimit);
+
+            foreach (var renderer in new[] { unlimited, limited })
+            {
+                Assert.True(renderer.LoadEffect(path), renderer.LastErrorMessage);
+                for (int i = 0; i < 20; i++)
+                {
+                    renderer.PlayEffect(path, i, 0, 0);
+                }
+                for (int frame = 0; frame < 30; frame++)
+                {
+                    renderer.Update(1.0f);
+                }
+            }
+
+            Assert.True(limited.AllocatedInstanceBytes < unlimited.AllocatedInstanceBytes,
+                $"limited {limited.AllocatedInstanceBytes} bytes, unlimited {unlimited.AllocatedInstanceBytes} bytes");
+        }
+
+        private static byte[] RenderCapturedFrame(EffekseerForNative.EffekseerRenderer renderer, string path, int frame)
+        {
+            if (frame % 10 == 0)
+            {
+                renderer.PlayEffect(path, frame % 40 - 20.0f, 0, 0);
+            }
+            renderer.Update(1.0f);
+            renderer.Render();
+            return renderer.GetCapturedVertices();
+        }
+
+        // 変更が拾われるまで Update を回し、recordCount 件目の記録が現れたらその行を返す
+        private static string? PollHotReload(EffekseerForNative.EffekseerRenderer renderer, int recordCount)
+        {
+            for (int i = 0; i < 50; i++)
+            {
+                renderer.Update(1.0f);
+                var records = renderer.HotReloadReport.Split('\n', StringSplitOptions.RemoveEmptyEntries);
+                if (records.Length >= recordCount) return records[recordCount - 1];
+                Thread.Sleep(20);
+            }
+            return null;
+        }
+
+        private static long SumAllocatedInstanceBytes(EffekseerForNative.EffekseerRenderer[] renderers)
+        {
+            long bytes = 0;
+            foreach (var renderer in renderers)
+            {
+                bytes += renderer.AllocatedInstanceBytes;
+            }
+            return bytes;
+        }
+    }
+}
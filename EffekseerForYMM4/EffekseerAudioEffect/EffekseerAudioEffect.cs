@@ -34,6 +34,11 @@ namespace EffekseerForYMM4.EffekseerAudioEffect
         public bool IsLoop { get => isLoop; set => Set(ref isLoop, value); }
         bool isLoop = true;
 
+        [Display(GroupName = nameof(Translate.Group_Effect), Name = nameof(Translate.Audio_ParallelExport_Name), Description = nameof(Translate.Audio_ParallelExport_Desc), ResourceType = typeof(Translate))]
+        [ToggleSlider]
+        public bool IsParallelExport { get => isParallelExport; set => Set(ref isParallelExport, value); }
+        bool isParallelExport = true;
+
         [Display(GroupName = nameof(Translate.Group_Camera), Name = nameof(Translate.Camera_X_Name), Description = nameof(Translate.Camera_X_Desc), ResourceType = typeof(Translate))]
         [AnimationSlider("F1", "m", -50, 50)]
         public Animation CamPosX { get; } = new Animation(0, -100000.0, 100000.0);
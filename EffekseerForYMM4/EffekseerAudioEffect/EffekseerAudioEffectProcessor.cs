@@ -1,57 +1,55 @@
 using System;
-using System.IO;
-using System.Runtime.InteropServices;
+using System.Diagnostics;
+using System.Threading;
+using System.Threading.Tasks;
 using EffekseerForYMM4.Commons;
-using YukkuriMovieMaker.Commons;
-using YukkuriMovieMaker.Player.Audio;
 using YukkuriMovieMaker.Player.Audio.Effects;
 
 namespace EffekseerForYMM4.EffekseerAudioEffect
 {
     internal class EffekseerAudioEffectProcessor : AudioEffectProcessorBase
     {
-        private const int EffekseerFps = 60;
-        private const int MaxReplaySteps = 600;
-        [UnmanagedFunctionPointer(CallingConvention.StdCall)]
-        public delegate int LoadSoundDelegate([MarshalAs(UnmanagedType.LPWStr)] string path);
-
-        [UnmanagedFunctionPointer(CallingConvention.StdCall)]
-        public delegate void UnloadSoundDelegate(int id);
-
-        [UnmanagedFunctionPointer(CallingConvention.StdCall)]
-        public delegate void PlaySoundDelegate(
-            int id, 
-            float volume, 
-            float pan, 
-            float pitch, 
-            [MarshalAs(UnmanagedType.I1)] bool mode3d, // C++のbool(1byte)に合わせる
-            float x, 
-            float y, 
-            float z, 
-            float distance);
-
         readonly EffekseerAudioEffect item;
         readonly TimeSpan duration;
 
-        private EffekseerForNative.EffekseerRenderer? nativeRenderer;
-        private EffekseerSoundMixer? mixer;
-        private LoadSoundDelegate? loadSoundDel;
-        private UnloadSoundDelegate? unloadSoundDel;
-        private PlaySoundDelegate? playSoundDel;
-
-        private string? loadedFilePath;
-        private double currentFrame = 0;
-        private bool isInitialized = false;
-        private long lastTimelineFrame = 0;
-        private bool hasLastTimelineFrame = false;
+        private EffekseerAudioRenderer? renderer;
         private readonly EffekseerLoadErrorNotifier loadErrorNotifier = new();
 
+        // 音声エフェクトには書き出し中かどうかが渡されないので、先頭から再生より十分速く読まれたら書き出しとみなす。
+        // 見誤ってプレビューで並列処理に入っても、区間の境界はリセット点だけなので音は逐次処理と変わらない
+        private const double ProbeSeconds = 1.0;
+        private const double MinExportSpeed = 4.0;
+        private long probeStartTimestamp;
+        private bool isExportProbed;
+
+        // 書き出しで並列に進めているブロック。最初の区間は read で逐次処理する
+        private EffekseerAudioBlock[]? segmentBlocks;
+        private Task<EffekseerAudioBlockResult?[]?>? segmentTask;
+        private CancellationTokenSource? segmentCancellation;
+        private int firstSimulatedBlock;
+        private int nextSegmentBlock;
+
         //出力サンプリングレート。リサンプリング処理をしない場合はInputのHzをそのまま返す。
         public override int Hz => Input?.Hz ?? 44100;
 
         //出力するサンプル数
         public override long Duration => (long)(duration.TotalSeconds * Hz);
 
+        /// <summary>
+        /// 並列処理で分ける区間の最大数
+        /// </summary>
+        public int SegmentCount { get; set; } = Environment.ProcessorCount;
+
+        /// <summary>
+        /// 最後に先頭から読み始めてから、並列処理で分けた区間の数。逐次処理だけで進めた場合は 0
+        /// </summary>
+        public int ParallelSegmentCount { get; private set; }
+
+        /// <summary>
+        /// 最後に先頭から読み始めてから、ワーカーの結果をミックスしたブロックの数
+        /// </summary>
+        public int ParallelBlockCount { get; private set; }
+
         public EffekseerAudioEffectProcessor(EffekseerAudioEffect item, TimeSpan duration)
         {
             this.item = item;
@@ -62,8 +60,10 @@ namespace EffekseerForYMM4.EffekseerAudioEffect
         protected override void seek(long position)
         {
             Input?.Seek(position);
-            hasLastTimelineFrame = false;
-            currentFrame = 0;
+            renderer?.Seek();
+            DropSegments();
+            probeStartTimestamp = 0;
+            isExportProbed = false;
         }
 
         //エフェクトを適用する
@@ -78,216 +78,105 @@ namespace EffekseerForYMM4.EffekseerAudioEffect
                 Array.Clear(destBuffer, offset + readCount, count - readCount);
             }
 
-            if (!isInitialized)
+            renderer ??= new EffekseerAudioRenderer(item, Hz, loadErrorNotifier);
+
+            // プレビューは実時間で読まれるので、並列処理は先頭から速く読み進められた場合だけにする
+            if (Position == 0)
             {
-                Initialize();
+                probeStartTimestamp = Stopwatch.GetTimestamp();
+                isExportProbed = false;
+                ParallelSegmentCount = 0;
+                ParallelBlockCount = 0;
             }
-
-            if (nativeRenderer == null || mixer == null) return count;
-            var renderer = nativeRenderer;
-            var soundMixer = mixer;
-
-            // Positionから現在のエフェクトフレームを計算（巻き戻し対応）
-            long totalSampleFrames = (long)(duration.TotalSeconds * Hz);
-            long currentSampleFrame = Position / 2; // Position is total samples (stereo), so divide by 2
-            double targetFrame = (double)currentSampleFrame / Hz * EffekseerFps;
-            long timelineFrame = (long)Math.Round((double)currentSampleFrame * EffekseerFps / Hz);
-            
-            // ファイル読み込み判定
-            if (loadedFilePath != item.FilePath)
+            else if (item.IsParallelExport && !isExportProbed && Position >= (long)(ProbeSeconds * Hz) * 2 && count > 0)
             {
-                if (!string.IsNullOrEmpty(item.FilePath))
+                isExportProbed = true;
+                if (probeStartTimestamp != 0 && Stopwatch.GetElapsedTime(probeStartTimestamp).TotalSeconds * MinExportSpeed < (double)Position / 2 / Hz)
                 {
-                    var ext = Path.GetExtension(item.FilePath).ToLowerInvariant();
-                    if (ext != ".efk" && ext != ".efkefc")
-                    {
-                        loadedFilePath = item.FilePath;
-                        loadErrorNotifier.ShowIfNeeded(item.FilePath, string.Format(Translate.Error_InvalidEffectExtension, ".efk, .efkefc"));
-                    }
-                    else if (!File.Exists(item.FilePath))
-                    {
-                        loadedFilePath = item.FilePath;
-                        loadErrorNotifier.ShowIfNeeded(item.FilePath, Translate.Error_EffectFileNotFound);
-                    }
-                    else if (renderer.LoadEffect(item.FilePath))
-                    {
-                        loadedFilePath = item.FilePath;
-                        loadErrorNotifier.Reset();
-                        currentFrame = 0; // 新しいファイル読み込み時にリセット
-                        hasLastTimelineFrame = false;
-                    }
-                    else
-                    {
-                        loadedFilePath = item.FilePath;
-                        loadErrorNotifier.ShowIfNeeded(item.FilePath, renderer.LastErrorMessage ?? Translate.Error_EffectFilesMayBeInvalid);
-                    }
-                }
-                else
-                {
-                    renderer.Reset();
-                    currentFrame = 0;
-                    hasLastTimelineFrame = false;
-                    loadErrorNotifier.Reset();
+                    PrepareSegments(count);
                 }
-                loadedFilePath = item.FilePath;
             }
 
-            if (!string.IsNullOrEmpty(loadedFilePath))
+            if (segmentBlocks != null && segmentTask != null)
             {
-                int totalFrames = renderer.GetTotalFrame();
-                
-                // ループ処理
-                if (item.IsLoop && totalFrames > 0 && totalFrames < int.MaxValue)
+                if (nextSegmentBlock < segmentBlocks.Length
+                    && segmentBlocks[nextSegmentBlock].Position == Position
+                    && segmentBlocks[nextSegmentBlock].Count == count)
                 {
-                    targetFrame = targetFrame % totalFrames;
-                }
-                
-                bool requiresReplay = RequiresReplay(timelineFrame);
-                if (!requiresReplay && item.IsLoop && totalFrames > 0 && targetFrame < currentFrame)
-                {
-                    requiresReplay = true;
-                }
+                    var segmentBlock = segmentBlocks[nextSegmentBlock];
+                    if (nextSegmentBlock < firstSimulatedBlock)
+                    {
+                        renderer.Render(destBuffer, offset, segmentBlock);
+                        nextSegmentBlock++;
+                        return count;
+                    }
 
-                // Update Emitter Transform
-                float ex = (float)item.PosX.GetValue(currentSampleFrame, totalSampleFrames, Hz);
-                float ey = (float)item.PosY.GetValue(currentSampleFrame, totalSampleFrames, Hz);
-                float ez = (float)item.PosZ.GetValue(currentSampleFrame, totalSampleFrames, Hz);
-                renderer.SetLocation(ex, ey, ez);
+                    // 2番目の区間に入ったらワーカーを待つ
+                    var results = segmentTask.Result;
+                    if (results != null && renderer.Mixer != null)
+                    {
+                        EffekseerSegmentedAudioRenderer.MixBlock(renderer.Mixer, destBuffer, offset, segmentBlock, results[nextSegmentBlock]!);
+                        nextSegmentBlock++;
+                        ParallelBlockCount++;
+                        return count;
+                    }
 
-                if (requiresReplay)
-                {
-                    ReplayRendererToTargetFrame(targetFrame);
+                    // ワーカーが失敗した場合は、ここまで逐次処理で進めているのでそのまま続ける
+                    DropSegments();
                 }
-
-                float delta = (float)(targetFrame - currentFrame);
-                if (!requiresReplay && delta > 0)
+                else
                 {
-                    renderer.Update(delta);
-                    currentFrame = targetFrame;
+                    // 想定外の読み方をされた場合は逐次処理に戻る（エフェクトは再生し直す）
+                    DropSegments();
+                    renderer.Seek();
                 }
-
-                // Update Camera Position
-                // totalSampleFrames と currentSampleFrame は既に上部で計算済み
-                float cx = (float)item.CamPosX.GetValue(currentSampleFrame, totalSampleFrames, Hz);
-                float cy = (float)item.CamPosY.GetValue(currentSampleFrame, totalSampleFrames, Hz);
-                float cz = (float)item.CamPosZ.GetValue(currentSampleFrame, totalSampleFrames, Hz);
-                
-                renderer.SetCameraLookAt(cx, cy, cz, 0, 0, 0, 0, 1, 0);
-                
-                // Also update listener position for sound mixer
-                soundMixer.SetListenerPosition(cx, cy, cz);
             }
 
-            // Mix Effekseer sound
-            soundMixer.Mix(destBuffer, offset, count);
-
-            // Apply Master Volume from item parameters (if using Animatable)
-            // item.Volume.GetValue returns 0-100?
-            // "F0", "%", 0, 100
-            // Use local variable totalSampleFrames to avoid dependency on Duration property implementation
-            long volTotalFrames = (long)(duration.TotalSeconds * Hz);
-            double itemVol = item.Volume.GetValue(Position / 2, volTotalFrames, Hz);
-            
-            float masterVol = (float)(itemVol / 100.0);
-            
-            if (masterVol != 1.0f)
-            {
-                for (int i = 0; i < count; i++)
-                {
-                    destBuffer[offset + i] *= masterVol;
-                }
-            }
+            var block = EffekseerAudioRenderer.CreateBlock(item, duration, Hz, Position, count);
+            renderer.Render(destBuffer, offset, block);
 
             return count; // Always return full count as we generate/mix
         }
 
-        private void Initialize()
+        /// <summary>
+        /// 現在位置から最後までを区間に分け、2番目以降の区間をバックグラウンドで進め始める
+        /// </summary>
+        private void PrepareSegments(int blockSize)
         {
-            if (isInitialized) return;
-
-            nativeRenderer = new EffekseerForNative.EffekseerRenderer();
-            
-            // Headless init
-            if (!nativeRenderer.Initialize(IntPtr.Zero, IntPtr.Zero, 800, 600))
-            {
-               // Failed
-               return;
-            }
-
-            mixer = new EffekseerSoundMixer(Hz);
-
-            // Create delegates
-            // Wrap LoadSound to resolve relative paths
-            loadSoundDel = new LoadSoundDelegate((path) => 
-            {
-                if (!string.IsNullOrEmpty(path) && !Path.IsPathRooted(path))
-                {
-                    if (!string.IsNullOrEmpty(item.FilePath))
-                    {
-                        var effectDir = Path.GetDirectoryName(item.FilePath);
-                        if (!string.IsNullOrEmpty(effectDir))
-                        {
-                            path = Path.Combine(effectDir, path);
-                        }
-                    }
-                }
-                return mixer!.LoadSound(path);
-            });
-            
-            unloadSoundDel = new UnloadSoundDelegate(mixer!.UnloadSound);
-            playSoundDel = new PlaySoundDelegate(mixer.PlaySound);
-
-            nativeRenderer.SetSoundCallback(
-                Marshal.GetFunctionPointerForDelegate(loadSoundDel),
-                Marshal.GetFunctionPointerForDelegate(unloadSoundDel),
-                Marshal.GetFunctionPointerForDelegate(playSoundDel)
-            );
+            // 読み込みエラーの通知とミキサーの作成はこちらで行う
+            renderer!.EnsureLoaded();
+            if (!renderer.IsAvailable || !renderer.HasEffect || SegmentCount < 2) return;
 
-            // Set camera to mimic video effect default (at 0,0,20 looking at 0,0,0)
-            nativeRenderer.SetCameraLookAt(0, 0, 20, 0, 0, 0, 0, 1, 0);
+            var blocks = EffekseerSegmentedAudioRenderer.PlanBlocks(item, duration, Hz, Position, Duration * 2, blockSize);
+            var resetPoints = EffekseerSegmentedAudioRenderer.FindResetPoints(blocks, Hz, renderer.TotalFrames, item.IsLoop, renderer.Timeline);
+            var segmentStarts = EffekseerSegmentedAudioRenderer.PlanSegments(resetPoints, blocks.Length, SegmentCount);
+            if (segmentStarts.Count < 2) return;
 
-            isInitialized = true;
-        }
-
-        private bool RequiresReplay(long timelineFrame)
-        {
-            if (!hasLastTimelineFrame)
+            var segmented = new EffekseerSegmentedAudioRenderer(item, Hz);
+            if (!segmented.CreateWorkers(segmentStarts.Count - 1))
             {
-                lastTimelineFrame = timelineFrame;
-                hasLastTimelineFrame = true;
-                return true;
+                segmented.Dispose();
+                return;
             }
 
-            var deltaFrames = timelineFrame - lastTimelineFrame;
-            lastTimelineFrame = timelineFrame;
-            return deltaFrames < 0 || deltaFrames > 1;
+            var cancellation = new CancellationTokenSource();
+            var token = cancellation.Token;
+            segmentTask = Task.Run(() => segmented.Simulate(blocks, segmentStarts, token));
+            segmentCancellation = cancellation;
+            segmentBlocks = blocks;
+            firstSimulatedBlock = segmentStarts[1];
+            nextSegmentBlock = 0;
+            ParallelSegmentCount = segmentStarts.Count;
         }
 
-        private void ReplayRendererToTargetFrame(double targetFrame)
+        private void DropSegments()
         {
-            if (nativeRenderer == null)
-            {
-                return;
-            }
-
-            nativeRenderer.Reset();
-            currentFrame = 0;
-
-            if (targetFrame <= 0)
-            {
-                return;
-            }
-
-            var replayStep = Math.Max(1.0, targetFrame / MaxReplaySteps);
-            var replayed = 0.0;
-            while (replayed < targetFrame)
-            {
-                var next = Math.Min(targetFrame, replayed + replayStep);
-                nativeRenderer.Update((float)(next - replayed));
-                replayed = next;
-            }
-
-            currentFrame = targetFrame;
+            segmentCancellation?.Cancel();
+            segmentCancellation?.Dispose();
+            segmentCancellation = null;
+            segmentTask = null;
+            segmentBlocks = null;
+            nextSegmentBlock = 0;
         }
 
         protected override void Dispose(bool disposing)
@@ -295,14 +184,10 @@ namespace EffekseerForYMM4.EffekseerAudioEffect
             base.Dispose(disposing);
             if (disposing)
             {
-                if (nativeRenderer != null)
-                {
-                    nativeRenderer.Destroy();
-                    nativeRenderer.Dispose();
-                    nativeRenderer = null;
-                }
+                DropSegments();
+                renderer?.Dispose();
+                renderer = null;
             }
-            // Keep delegates alive until here? Yes.
         }
     }
 }
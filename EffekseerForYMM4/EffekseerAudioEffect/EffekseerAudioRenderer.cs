@@ -0,0 +1,370 @@
+using System;
+using System.IO;
+using System.Runtime.InteropServices;
+using EffekseerForYMM4.Commons;
+
+namespace EffekseerForYMM4.EffekseerAudioEffect
+{
+    /// <summary>
+    /// 1回の read で処理する範囲と、その位置でのアニメーション値
+    /// </summary>
+    internal struct EffekseerAudioBlock
+    {
+        public long Position; // In samples (stereo)
+        public int Count;
+        public float EmitterX, EmitterY, EmitterZ;
+        public float CameraX, CameraY, CameraZ;
+        public float MasterVolume;
+    }
+
+    /// <summary>
+    /// エフェクトの再生位置。ブロックごとに AdvanceTimeline で進める。
+    /// </summary>
+    internal struct EffekseerAudioTimeline
+    {
+        public double CurrentFrame;
+        public long LastTimelineFrame;
+        public bool HasLastTimelineFrame;
+    }
+
+    /// <summary>
+    /// ヘッドレスの EffekseerRenderer と EffekseerSoundMixer でエフェクトを進めて音を鳴らす
+    /// </summary>
+    internal sealed class EffekseerAudioRenderer : IDisposable
+    {
+        public const int EffekseerFps = 60;
+        private const int MaxReplaySteps = 600;
+
+        [UnmanagedFunctionPointer(CallingConvention.StdCall)]
+        public delegate int LoadSoundDelegate([MarshalAs(UnmanagedType.LPWStr)] string path);
+
+        [UnmanagedFunctionPointer(CallingConvention.StdCall)]
+        public delegate void UnloadSoundDelegate(int id);
+
+        [UnmanagedFunctionPointer(CallingConvention.StdCall)]
+        public delegate void PlaySoundDelegate(
+            int id,
+            float volume,
+            float pan,
+            float pitch,
+            [MarshalAs(UnmanagedType.I1)] bool mode3d, // C++のbool(1byte)に合わせる
+            float x,
+            float y,
+            float z,
+            float distance);
+
+        readonly EffekseerAudioEffect item;
+        readonly int hz;
+        readonly EffekseerLoadErrorNotifier? loadErrorNotifier;
+
+        private EffekseerForNative.EffekseerRenderer? nativeRenderer;
+        private EffekseerSoundMixer? mixer;
+        private LoadSoundDelegate? loadSoundDel;
+        private UnloadSoundDelegate? unloadSoundDel;
+        private PlaySoundDelegate? playSoundDel;
+
+        private string? loadedFilePath;
+        private EffekseerAudioTimeline timeline;
+        private bool isInitialized = false;
+
+        /// <param name="loadErrorNotifier">読み込みエラーを表示する場合に指定する</param>
+        public EffekseerAudioRenderer(EffekseerAudioEffect item, int hz, EffekseerLoadErrorNotifier? loadErrorNotifier)
+        {
+            this.item = item;
+            this.hz = hz;
+            this.loadErrorNotifier = loadErrorNotifier;
+        }
+
+        public EffekseerSoundMixer? Mixer => mixer;
+
+        public bool IsAvailable => nativeRenderer != null && mixer != null;
+
+        /// <summary>
+        /// エフェクトを進める必要があるか。読み込みに失敗したファイルでも true になる（逐次処理と揃えるため）。
+        /// </summary>
+        public bool HasEffect => !string.IsNullOrEmpty(loadedFilePath);
+
+        public int TotalFrames => nativeRenderer?.GetTotalFrame() ?? 0;
+
+        public EffekseerAudioTimeline Timeline => timeline;
+
+        public static EffekseerAudioBlock CreateBlock(EffekseerAudioEffect item, TimeSpan duration, int hz, long position, int count)
+        {
+            long totalSampleFrames = (long)(duration.TotalSeconds * hz);
+            long currentSampleFrame = position / 2; // Position is total samples (stereo), so divide by 2
+
+            return new EffekseerAudioBlock
+            {
+                Position = position,
+                Count = count,
+                EmitterX = (float)item.PosX.GetValue(currentSampleFrame, totalSampleFrames, hz),
+                EmitterY = (float)item.PosY.GetValue(currentSampleFrame, totalSampleFrames, hz),
+                EmitterZ = (float)item.PosZ.GetValue(currentSampleFrame, totalSampleFrames, hz),
+                CameraX = (float)item.CamPosX.GetValue(currentSampleFrame, totalSampleFrames, hz),
+                CameraY = (float)item.CamPosY.GetValue(currentSampleFrame, totalSampleFrames, hz),
+                CameraZ = (float)item.CamPosZ.GetValue(currentSampleFrame, totalSampleFrames, hz),
+                // item.Volume is 0-100 ("F0", "%", 0, 100)
+                MasterVolume = (float)(item.Volume.GetValue(currentSampleFrame, totalSampleFrames, hz) / 100.0),
+            };
+        }
+
+        /// <summary>
+        /// ブロックの位置までタイムラインを進める。
+        /// 戻り値が true のときは、エフェクトを最初から targetFrame まで再生し直す（それまでの状態に依存しない）。
+        /// </summary>
+        public static bool AdvanceTimeline(ref EffekseerAudioTimeline timeline, long position, int hz, int totalFrames, bool isLoop, out double targetFrame, out float delta)
+        {
+            // Positionから現在のエフェクトフレームを計算（巻き戻し対応）
+            long currentSampleFrame = position / 2;
+            targetFrame = (double)currentSampleFrame / hz * EffekseerFps;
+            long timelineFrame = (long)Math.Round((double)currentSampleFrame * EffekseerFps / hz);
+
+            // ループ処理
+            if (isLoop && totalFrames > 0 && totalFrames < int.MaxValue)
+            {
+                targetFrame = targetFrame % totalFrames;
+            }
+
+            bool requiresReplay;
+            if (!timeline.HasLastTimelineFrame)
+            {
+                timeline.LastTimelineFrame = timelineFrame;
+                timeline.HasLastTimelineFrame = true;
+                requiresReplay = true;
+            }
+            else
+            {
+                var deltaFrames = timelineFrame - timeline.LastTimelineFrame;
+                timeline.LastTimelineFrame = timelineFrame;
+                requiresReplay = deltaFrames < 0 || deltaFrames > 1;
+            }
+
+            if (!requiresReplay && isLoop && totalFrames > 0 && targetFrame < timeline.CurrentFrame)
+            {
+                requiresReplay = true;
+            }
+
+            if (requiresReplay)
+            {
+                timeline.CurrentFrame = Math.Max(0, targetFrame);
+                delta = 0;
+                return true;
+            }
+
+            delta = (float)(targetFrame - timeline.CurrentFrame);
+            if (delta > 0)
+            {
+                timeline.CurrentFrame = targetFrame;
+            }
+            return false;
+        }
+
+        public static void ApplyVolume(float[] buffer, int offset, int count, float masterVol)
+        {
+            if (masterVol != 1.0f)
+            {
+                for (int i = 0; i < count; i++)
+                {
+                    buffer[offset + i] *= masterVol;
+                }
+            }
+        }
+
+        /// <summary>
+        /// 次のブロックでエフェクトを再生し直す
+        /// </summary>
+        public void Seek()
+        {
+            timeline = default;
+        }
+
+        /// <summary>
+        /// エフェクトを進めてミックスする
+        /// </summary>
+        public void Render(float[] destBuffer, int offset, in EffekseerAudioBlock block)
+        {
+            Simulate(block);
+            if (mixer == null) return;
+
+            // Mix Effekseer sound
+            mixer.Mix(destBuffer, offset, block.Count);
+
+            ApplyVolume(destBuffer, offset, block.Count, block.MasterVolume);
+        }
+
+        /// <summary>
+        /// エフェクトを進める。鳴った音は Mixer のボイスに追加される。
+        /// </summary>
+        public void Simulate(in EffekseerAudioBlock block)
+        {
+            if (!isInitialized)
+            {
+                Initialize();
+            }
+
+            if (nativeRenderer == null || mixer == null) return;
+            var renderer = nativeRenderer;
+            var soundMixer = mixer;
+
+            EnsureLoaded();
+
+            if (!string.IsNullOrEmpty(loadedFilePath))
+            {
+                int totalFrames = renderer.GetTotalFrame();
+                bool requiresReplay = AdvanceTimeline(ref timeline, block.Position, hz, totalFrames, item.IsLoop, out var targetFrame, out var delta);
+
+                // Update Emitter Transform
+                renderer.SetLocation(block.EmitterX, block.EmitterY, block.EmitterZ);
+
+                if (requiresReplay)
+                {
+                    ReplayRendererToTargetFrame(targetFrame);
+                }
+                else if (delta > 0)
+                {
+                    renderer.Update(delta);
+                }
+
+                // Update Camera Position
+                renderer.SetCameraLookAt(block.CameraX, block.CameraY, block.CameraZ, 0, 0, 0, 0, 1, 0);
+
+                // Also update listener position for sound mixer
+                soundMixer.SetListenerPosition(block.CameraX, block.CameraY, block.CameraZ);
+            }
+        }
+
+        /// <summary>
+        /// item.FilePath が変わっていれば読み込み直す
+        /// </summary>
+        public void EnsureLoaded()
+        {
+            if (!isInitialized)
+            {
+                Initialize();
+            }
+
+            var renderer = nativeRenderer;
+            if (renderer == null || mixer == null) return;
+
+            // ファイル読み込み判定
+            if (loadedFilePath != item.FilePath)
+            {
+                if (!string.IsNullOrEmpty(item.FilePath))
+                {
+                    var ext = Path.GetExtension(item.FilePath).ToLowerInvariant();
+                    if (ext != ".efk" && ext != ".efkefc")
+                    {
+                        loadedFilePath = item.FilePath;
+                        loadErrorNotifier?.ShowIfNeeded(item.FilePath, string.Format(Translate.Error_InvalidEffectExtension, ".efk, .efkefc"));
+                    }
+                    else if (!File.Exists(item.FilePath))
+                    {
+                        loadedFilePath = item.FilePath;
+                        loadErrorNotifier?.ShowIfNeeded(item.FilePath, Translate.Error_EffectFileNotFound);
+                    }
+                    else if (renderer.LoadEffect(item.FilePath))
+                    {
+                        loadedFilePath = item.FilePath;
+                        loadErrorNotifier?.Reset();
+                        timeline = default; // 新しいファイル読み込み時にリセット
+                    }
+                    else
+                    {
+                        loadedFilePath = item.FilePath;
+                        loadErrorNotifier?.ShowIfNeeded(item.FilePath, renderer.LastErrorMessage ?? Translate.Error_EffectFilesMayBeInvalid);
+                    }
+                }
+                else
+                {
+                    renderer.Reset();
+                    timeline = default;
+                    loadErrorNotifier?.Reset();
+                }
+                loadedFilePath = item.FilePath;
+            }
+        }
+
+        private void Initialize()
+        {
+            if (isInitialized) return;
+
+            nativeRenderer = new EffekseerForNative.EffekseerRenderer();
+
+            // Headless init
+            if (!nativeRenderer.Initialize(IntPtr.Zero, IntPtr.Zero, 800, 600))
+            {
+               // Failed
+               return;
+            }
+
+            mixer = new EffekseerSoundMixer(hz);
+
+            // Create delegates
+            // Wrap LoadSound to resolve relative paths
+            loadSoundDel = new LoadSoundDelegate((path) =>
+            {
+                if (!string.IsNullOrEmpty(path) && !Path.IsPathRooted(path))
+                {
+                    if (!string.IsNullOrEmpty(item.FilePath))
+                    {
+                        var effectDir = Path.GetDirectoryName(item.FilePath);
+                        if (!string.IsNullOrEmpty(effectDir))
+                        {
+                            path = Path.Combine(effectDir, path);
+                        }
+                    }
+                }
+                return mixer!.LoadSound(path);
+            });
+
+            unloadSoundDel = new UnloadSoundDelegate(mixer!.UnloadSound);
+            playSoundDel = new PlaySoundDelegate(mixer.PlaySound);
+
+            nativeRenderer.SetSoundCallback(
+                Marshal.GetFunctionPointerForDelegate(loadSoundDel),
+                Marshal.GetFunctionPointerForDelegate(unloadSoundDel),
+                Marshal.GetFunctionPointerForDelegate(playSoundDel)
+            );
+
+            // Set camera to mimic video effect default (at 0,0,20 looking at 0,0,0)
+            nativeRenderer.SetCameraLookAt(0, 0, 20, 0, 0, 0, 0, 1, 0);
+
+            isInitialized = true;
+        }
+
+        private void ReplayRendererToTargetFrame(double targetFrame)
+        {
+            if (nativeRenderer == null)
+            {
+                return;
+            }
+
+            nativeRenderer.Reset();
+
+            if (targetFrame <= 0)
+            {
+                return;
+            }
+
+            var replayStep = Math.Max(1.0, targetFrame / MaxReplaySteps);
+            var replayed = 0.0;
+            while (replayed < targetFrame)
+            {
+                var next = Math.Min(targetFrame, replayed + replayStep);
+                nativeRenderer.Update((float)(next - replayed));
+                replayed = next;
+            }
+        }
+
+        public void Dispose()
+        {
+            if (nativeRenderer != null)
+            {
+                nativeRenderer.Destroy();
+                nativeRenderer.Dispose();
+                nativeRenderer = null;
+            }
+            // Keep delegates alive until here? Yes.
+        }
+    }
+}
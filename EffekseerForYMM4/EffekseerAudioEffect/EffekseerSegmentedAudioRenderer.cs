@@ -0,0 +1,204 @@
+using System;
+using System.Collections.Generic;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace EffekseerForYMM4.EffekseerAudioEffect
+{
+    /// <summary>
+    /// ブロックで鳴り始めたボイスと、そのブロックでのリスナー位置
+    /// </summary>
+    internal sealed class EffekseerAudioBlockResult
+    {
+        public float ListenerX, ListenerY, ListenerZ;
+        public List<EffekseerVoice> Voices = new();
+    }
+
+    /// <summary>
+    /// 書き出し用に、エフェクトの進行を複数スレッドで並列に行う。
+    ///
+    /// 残りのブロックを区間に分け、最初の区間は呼び出し元が逐次処理で進める。
+    /// 2番目以降の区間は、ヘッドレスの EffekseerRenderer と EffekseerSoundMixer を持つワーカーが1区間ずつ進め、
+    /// 各ブロックで鳴り始めたボイスを記録する。
+    /// ミックスは MixBlock で先頭から順に呼び出し元のミキサーで行うので、区間の境界で鳴り続けているボイスはそのまま次の区間に引き継がれる。
+    ///
+    /// 区間の境界は、逐次処理でもエフェクトを最初から再生し直すブロック（タイムラインの飛び・ループの折り返し）だけに置く。
+    /// そこでは逐次処理もそれまでの状態を使わないので、結果は逐次処理とサンプル単位で一致する。
+    /// そのようなブロックがなければ（ループしない長いエフェクトを細かく読む場合など）区間に分けず、逐次処理のままにする。
+    /// </summary>
+    internal sealed class EffekseerSegmentedAudioRenderer : IDisposable
+    {
+        /// <summary>
+        /// 区間の最小のブロック数。プリロールの分だけ短い区間は割に合わない
+        /// </summary>
+        public const int MinSegmentBlocks = 32;
+
+        readonly EffekseerAudioEffect item;
+        readonly int hz;
+        readonly List<EffekseerAudioRenderer> workers = new();
+
+        public EffekseerSegmentedAudioRenderer(EffekseerAudioEffect item, int hz)
+        {
+            this.item = item;
+            this.hz = hz;
+        }
+
+        /// <summary>
+        /// startPosition から totalSamples までを blockSize ごとに区切り、各ブロックのアニメーション値を求める。
+        /// Animation はスレッドセーフではないので、呼び出し元のスレッドで行う。
+        /// </summary>
+        public static EffekseerAudioBlock[] PlanBlocks(EffekseerAudioEffect item, TimeSpan duration, int hz, long startPosition, long totalSamples, int blockSize)
+        {
+            var blockCount = (int)Math.Max(0, (totalSamples - startPosition + blockSize - 1) / blockSize);
+            var blocks = new EffekseerAudioBlock[blockCount];
+            for (int i = 0; i < blockCount; i++)
+            {
+                long position = startPosition + (long)i * blockSize;
+                int count = (int)Math.Min(blockSize, totalSamples - position);
+                blocks[i] = EffekseerAudioRenderer.CreateBlock(item, duration, hz, position, count);
+            }
+            return blocks;
+        }
+
+        /// <summary>
+        /// 逐次処理でエフェクトを再生し直すブロックの番号。
+        /// timeline は最初のブロックの直前の再生位置（先頭から読む場合は default で、ブロック 0 が含まれる）
+        /// </summary>
+        public static List<int> FindResetPoints(IReadOnlyList<EffekseerAudioBlock> blocks, int hz, int totalFrames, bool isLoop, EffekseerAudioTimeline timeline)
+        {
+            var resetPoints = new List<int>();
+            for (int i = 0; i < blocks.Count; i++)
+            {
+                if (EffekseerAudioRenderer.AdvanceTimeline(ref timeline, blocks[i].Position, hz, totalFrames, isLoop, out _, out _))
+                {
+                    resetPoints.Add(i);
+                }
+            }
+            return resetPoints;
+        }
+
+        /// <summary>
+        /// blockCount 個のブロックを最大 segmentCount 個の区間に分け、各区間の先頭のブロック番号を返す（先頭は常に 0）。
+        /// 均等に分けた位置に最も近いリセット点を境界にする。区間が MinSegmentBlocks より短くなる境界は使わない。
+        /// </summary>
+        public static List<int> PlanSegments(List<int> resetPoints, int blockCount, int segmentCount)
+        {
+            var starts = new List<int> { 0 };
+            segmentCount = Math.Min(segmentCount, blockCount / MinSegmentBlocks);
+            if (segmentCount < 2) return starts;
+
+            for (int s = 1; s < segmentCount; s++)
+            {
+                int target = (int)((long)blockCount * s / segmentCount);
+                int index = resetPoints.BinarySearch(target);
+                if (index < 0)
+                {
+                    index = ~index;
+                    if (index == resetPoints.Count || (index > 0 && target - resetPoints[index - 1] <= resetPoints[index] - target))
+                    {
+                        index--;
+                    }
+                }
+                if (index < 0) break;
+
+                int start = resetPoints[index];
+                if (start - starts[^1] >= MinSegmentBlocks && blockCount - start >= MinSegmentBlocks)
+                {
+                    starts.Add(start);
+                }
+            }
+            return starts;
+        }
+
+        /// <summary>
+        /// ワーカーを count 個用意する。
+        /// ネイティブ側の初期化はスレッドセーフではないので、呼び出し元のスレッドで順番に作成と読み込みを行う。
+        /// </summary>
+        public bool CreateWorkers(int count)
+        {
+            while (workers.Count < count)
+            {
+                var worker = new EffekseerAudioRenderer(item, hz, null);
+                workers.Add(worker);
+                worker.EnsureLoaded();
+                if (!worker.IsAvailable) return false;
+            }
+            return true;
+        }
+
+        /// <summary>
+        /// 2番目以降の区間のエフェクトを進める。最初の区間のブロックの結果は null になる。
+        /// ワーカーは区間ごとに1つ必要（CreateWorkers で segmentStarts.Count - 1 個）で、終了時に破棄する。
+        /// 失敗した場合とキャンセルされた場合は null を返す。
+        /// </summary>
+        public EffekseerAudioBlockResult?[]? Simulate(EffekseerAudioBlock[] blocks, IReadOnlyList<int> segmentStarts, CancellationToken cancellationToken)
+        {
+            try
+            {
+                if (workers.Count < segmentStarts.Count - 1) return null;
+
+                var results = new EffekseerAudioBlockResult?[blocks.Length];
+                Parallel.For(1, segmentStarts.Count, new ParallelOptions { MaxDegreeOfParallelism = Math.Max(1, workers.Count) }, s =>
+                {
+                    var worker = workers[s - 1];
+                    var mixer = worker.Mixer!;
+                    int begin = segmentStarts[s];
+                    int end = s + 1 < segmentStarts.Count ? segmentStarts[s + 1] : blocks.Length;
+
+                    // 区間の先頭はリセット点なので、エフェクトの状態は逐次処理と同じく最初から作り直される。
+                    // 1つ前のブロックを進めておくのは、リセット点での再生し直しを逐次処理と同じリスナー位置で行うため。
+                    // そこまでに鳴り始めたボイスは前の区間の結果から引き継がれるので捨てる
+                    worker.Seek();
+                    worker.Simulate(blocks[begin - 1]);
+                    mixer.TakeVoices();
+
+                    for (int i = begin; i < end; i++)
+                    {
+                        if (cancellationToken.IsCancellationRequested) return;
+
+                        worker.Simulate(blocks[i]);
+
+                        var result = new EffekseerAudioBlockResult { Voices = mixer.TakeVoices() };
+                        mixer.GetListenerPosition(out result.ListenerX, out result.ListenerY, out result.ListenerZ);
+                        results[i] = result;
+                    }
+                });
+
+                return cancellationToken.IsCancellationRequested ? null : results;
+            }
+            catch (AggregateException)
+            {
+                return null;
+            }
+            finally
+            {
+                Dispose();
+            }
+        }
+
+        /// <summary>
+        /// Simulate の結果を1ブロック分ミックスする。ブロックの順に呼び出すこと。
+        /// </summary>
+        public static void MixBlock(EffekseerSoundMixer mixer, float[] destBuffer, int offset, in EffekseerAudioBlock block, EffekseerAudioBlockResult result)
+        {
+            mixer.SetListenerPosition(result.ListenerX, result.ListenerY, result.ListenerZ);
+            foreach (var voice in result.Voices)
+            {
+                mixer.AddVoice(voice);
+            }
+
+            mixer.Mix(destBuffer, offset, block.Count);
+
+            EffekseerAudioRenderer.ApplyVolume(destBuffer, offset, block.Count, block.MasterVolume);
+        }
+
+        public void Dispose()
+        {
+            foreach (var worker in workers)
+            {
+                worker.Dispose();
+            }
+            workers.Clear();
+        }
+    }
+}
@@ -75,6 +75,40 @@ namespace EffekseerForYMM4
             }
         }
 
+        public void GetListenerPosition(out float x, out float y, out float z)
+        {
+            lock (lockObj)
+            {
+                x = listenerX;
+                y = listenerY;
+                z = listenerZ;
+            }
+        }
+
+        /// <summary>
+        /// PlaySound で追加された順にボイスを取り出す（Mix されていないもの）
+        /// </summary>
+        public List<EffekseerVoice> TakeVoices()
+        {
+            lock (lockObj)
+            {
+                var taken = voices;
+                voices = new List<EffekseerVoice>();
+                return taken;
+            }
+        }
+
+        /// <summary>
+        /// 別のミキサーで開始したボイスを引き継ぐ
+        /// </summary>
+        public void AddVoice(EffekseerVoice voice)
+        {
+            lock (lockObj)
+            {
+                voices.Add(voice);
+            }
+        }
+
         public int LoadSound(string path)
         {
             try
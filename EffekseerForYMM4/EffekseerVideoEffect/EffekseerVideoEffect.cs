@@ -35,6 +35,11 @@ namespace EffekseerForYMM4
         public bool IsLoop { get => isLoop; set => Set(ref isLoop, value); }
         bool isLoop = true;
 
+        [Display(GroupName = nameof(Translate.Group_Effect), Name = nameof(Translate.Video_HotReload_Name), Description = nameof(Translate.Video_HotReload_Desc), ResourceType = typeof(Translate))]
+        [ToggleSlider]
+        public bool IsHotReload { get => isHotReload; set => Set(ref isHotReload, value); }
+        bool isHotReload = true;
+
         [Display(GroupName = nameof(Translate.Group_Camera), Name = nameof(Translate.Camera_X_Name), Description = nameof(Translate.Camera_X_Desc), ResourceType = typeof(Translate))]
         [AnimationSlider("F1", "m", -50, 50)]
         public Animation CamPosX { get; } = new Animation(0, -100000.0, 100000.0);
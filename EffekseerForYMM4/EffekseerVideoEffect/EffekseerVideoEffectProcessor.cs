@@ -39,6 +39,7 @@ namespace EffekseerForYMM4
         private int lastHeight = 0;
 
         private string? loadedFilePath = null;
+        private bool isHotReloadEnabled = false;
         private ID2D1Image? inputImage;
         private readonly EffekseerLoadErrorNotifier loadErrorNotifier = new();
 
@@ -133,6 +134,15 @@ namespace EffekseerForYMM4
                 CreateResources(width, height);
             }
 
+            // 編集中の .efkefc やテクスチャが保存されたら再生位置を保ったまま差し替える。
+            // 書き出し中はファイルの監視もしない
+            bool hotReload = item.IsHotReload && effectDescription.Usage != TimelineSourceUsage.Exporting;
+            if (nativeRenderer != null && isHotReloadEnabled != hotReload)
+            {
+                nativeRenderer.EnableHotReload(hotReload, 300);
+                isHotReloadEnabled = hotReload;
+            }
+
             if (loadedFilePath != item.FilePath)
             {
                 if (nativeRenderer == null)
@@ -182,6 +192,11 @@ namespace EffekseerForYMM4
             }
 
             int totalFrames = nativeRenderer.GetTotalFrame();
+            if (totalFrames > 0 && totalFrames < int.MaxValue)
+            {
+                // ホットリロードで長さが変わることがある
+                _duration = TimeSpan.FromSeconds((double)totalFrames / EffekseerFps);
+            }
             // 差分更新ではなく絶対時刻から毎回再構築する。
             // プレビューとサムネイルで Update の呼ばれ方が違っても同じ見た目に揃える。
             double targetFrame = Math.Max(0, effectDescription.ItemPosition.Time.TotalSeconds * EffekseerFps);